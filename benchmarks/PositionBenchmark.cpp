@@ -0,0 +1,87 @@
+#include "ByteBuffer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+// Microbenchmark of position-heavy field access: packs and unpacks fields of mixed widths at
+// every bit offset of a buffer. The table-driven ByteBuffer::get/set are compared with the
+// bit-by-bit loop they replaced, which steps a BitPosition once per bit.
+
+namespace {
+
+constexpr size_t bufferBytes = 4096;
+constexpr unsigned widths[] = {3, 7, 12, 17, 29, 32};
+constexpr int rounds = 200;
+
+/// @brief The former implementation of `set`: one position increment and one bit write per bit.
+void bitwiseSet(uint8_t* p, ByteBuffer::BitPosition pos, uint32_t value, unsigned bitCount) {
+    ByteBuffer::BitPosition end = pos + static_cast<int>(bitCount);
+    for (unsigned idx = 0; pos < end; pos++, idx++) {
+        uint8_t mask = static_cast<uint8_t>(1 << pos.getBitPos());
+        if ((value >> idx) & 1) {
+            p[pos.getBytePos()] |= mask;
+        } else {
+            p[pos.getBytePos()] &= static_cast<uint8_t>(~mask);
+        }
+    }
+}
+
+/// @brief The former implementation of `get`.
+uint32_t bitwiseGet(const uint8_t* p, ByteBuffer::BitPosition pos, unsigned bitCount) {
+    ByteBuffer::BitPosition end = pos + static_cast<int>(bitCount);
+    uint32_t ret = 0;
+    for (unsigned idx = 0; pos < end; pos++, idx++) {
+        ret |= static_cast<uint32_t>((p[pos.getBytePos()] >> pos.getBitPos()) & 1) << idx;
+    }
+    return ret;
+}
+
+/// @brief Run `body(pos, width, value)` over the buffer for all rounds; return nanoseconds per field.
+template <typename F>
+double timeFields(F body, uint64_t& fields) {
+    auto start = std::chrono::steady_clock::now();
+    fields = 0;
+    for (int r = 0; r < rounds; r++) {
+        ByteBuffer::BitPosition pos;
+        uint32_t value = static_cast<uint32_t>(r) * 2654435761u;
+        for (size_t i = 0;; i++) {
+            unsigned width = widths[i % (sizeof(widths) / sizeof(widths[0]))];
+            if (pos.getBitIndex() + width > bufferBytes * ByteBuffer::bitPerByte) {
+                break;
+            }
+            body(pos, width, value);
+            pos += width;
+            value = value * 1664525u + 1013904223u;
+            fields++;
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(fields);
+}
+
+}
+
+int main() {
+    ByteBuffer::ByteBuffer<bufferBytes> b;
+    uint64_t fields = 0;
+    uint64_t sink = 0;
+
+    double tableSet = timeFields([&b](ByteBuffer::BitPosition pos, unsigned width, uint32_t value) {
+        b.set(pos, value, static_cast<uint8_t>(width));
+    }, fields);
+    double tableGet = timeFields([&b, &sink](ByteBuffer::BitPosition pos, unsigned width, uint32_t) {
+        sink += b.get<uint32_t>(pos, static_cast<uint8_t>(width));
+    }, fields);
+    double bitwiseSetNs = timeFields([&b](ByteBuffer::BitPosition pos, unsigned width, uint32_t value) {
+        bitwiseSet(b.data(), pos, value, width);
+    }, fields);
+    double bitwiseGetNs = timeFields([&b, &sink](ByteBuffer::BitPosition pos, unsigned width, uint32_t) {
+        sink += bitwiseGet(b.getData(), pos, width);
+    }, fields);
+
+    std::cout << fields << " fields per run (checksum " << sink << ")\n";
+    std::cout << "set: " << tableSet << " ns/field with mask tables, " << bitwiseSetNs << " ns/field bit by bit\n";
+    std::cout << "get: " << tableGet << " ns/field with mask tables, " << bitwiseGetNs << " ns/field bit by bit\n";
+    return 0;
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "ByteBuffer.hpp"
+#include "ParallelOps.hpp"
+#include "ThreadPool.hpp"
+
+/// @file
+/// @brief Parallel decoding of batches of buffers into column-wise (SoA) outputs.
+
+namespace ByteBuffer  {
+
+/// @brief Uninitialized output columns for `BatchDecoder`, one array of `rows` values per field.
+/// @details The arrays are allocated without being written, so for large batches each memory page
+/// is first touched, and thus placed on the NUMA node of, the worker that decodes into it.
+/// @tparam T Integral value type.
+template <typename T>
+class DecodedColumns {
+        static_assert(std::is_integral<T>::value,"only integral types are allowed");
+
+    public:
+        /// @brief Allocate `columns` arrays of `rows` values each; the values are unspecified.
+        DecodedColumns(size_t columns, size_t rows) : rowCount(rows), storage(columns), ptrs(columns) {
+            for (size_t c = 0; c < columns; c++) {
+                storage[c].reset(new T[rows]);
+                ptrs[c] = storage[c].get();
+            }
+        }
+
+        /// @brief Return the number of columns.
+        size_t columns() const { return ptrs.size(); }
+
+        /// @brief Return the number of values per column.
+        size_t rows() const { return rowCount; }
+
+        /// @brief Return the values of column `c`.
+        T* column(size_t c) { return ptrs[c]; }
+
+        /// @brief Return the values of column `c`.
+        const T* column(size_t c) const { return ptrs[c]; }
+
+        /// @brief Return the column pointers as expected by `BatchDecoder::decode`.
+        T* const* data() const { return ptrs.data(); }
+
+    private:
+        size_t rowCount;
+        std::vector<std::unique_ptr<T[]>> storage;
+        std::vector<T*> ptrs;
+};
+
+namespace detail {
+
+/// @brief Record ranges of the participants of a parallel batch with work stealing.
+/// @details Each participant starts with an equal contiguous share of the records (so the output
+/// pages it touches first are its own) and takes chunks from the front of its share. A chunk is a
+/// quarter of what is left, but at least `grain` records, so chunks shrink as the share drains.
+/// A participant whose share is empty steals the back half of another share. A share is one
+/// atomic word (`begin << 32 | end`), so taking and stealing are single compare-exchanges.
+class StealingRanges {
+    public:
+        StealingRanges(uint32_t count, size_t participants, uint32_t grain)
+            : slots(new Slot[participants]), participants(participants), grain(grain) {
+            for (size_t p = 0; p < participants; p++) {
+                uint64_t b = static_cast<uint64_t>(count) * p / participants;
+                uint64_t e = static_cast<uint64_t>(count) * (p + 1) / participants;
+                slots[p].range.store(pack(b, e), std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Claim the next chunk `[begin, end)` for participant `self`.
+        /// @return false once no work is left to take or steal.
+        bool next(size_t self, size_t& begin, size_t& end) {
+            for (;;) {
+                if (take(self, begin, end)) {
+                    return true;
+                }
+                if (!steal(self)) {
+                    return false;
+                }
+            }
+        }
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> range{0};
+            char pad[cacheLineSize - sizeof(std::atomic<uint64_t>)];
+        };
+
+        static uint64_t pack(uint64_t b, uint64_t e) { return b << 32 | e; }
+        static uint64_t first(uint64_t r) { return r >> 32; }
+        static uint64_t last(uint64_t r) { return r & 0xffffffffu; }
+
+        bool take(size_t self, size_t& begin, size_t& end) {
+            std::atomic<uint64_t>& range = slots[self].range;
+            uint64_t r = range.load(std::memory_order_relaxed);
+            for (;;) {
+                uint64_t b = first(r);
+                uint64_t e = last(r);
+                if (b >= e) {
+                    return false;
+                }
+                uint64_t n = std::min(e - b, std::max<uint64_t>(grain, (e - b) / 4));
+                if (range.compare_exchange_weak(r, pack(b + n, e), std::memory_order_relaxed)) {
+                    begin = static_cast<size_t>(b);
+                    end = static_cast<size_t>(b + n);
+                    return true;
+                }
+            }
+        }
+
+        bool steal(size_t self) {
+            for (size_t k = 1; k < participants; k++) {
+                std::atomic<uint64_t>& victim = slots[(self + k) % participants].range;
+                uint64_t r = victim.load(std::memory_order_relaxed);
+                while (last(r) > first(r) + grain) {
+                    uint64_t mid = first(r) + (last(r) - first(r)) / 2;
+                    if (victim.compare_exchange_weak(r, pack(first(r), mid), std::memory_order_relaxed)) {
+                        // the own share is empty, so no other participant modifies it concurrently
+                        slots[self].range.store(pack(mid, last(r)), std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        std::unique_ptr<Slot[]> slots;
+        size_t participants;
+        uint32_t grain;
+};
+
+}
+
+/// @brief Decodes the same set of fields from batches of `ByteBuffer<Bytes>` into output columns.
+/// @details Field `f` of record `i` is written to `columns[f][i]`, using the bit order of
+/// `ByteBuffer::get`. Large batches are split over a `ThreadPool` with work stealing (see
+/// `detail::StealingRanges`); the smallest chunk covers about 16 KiB of input and output.
+/// Building the decoder allocates; decoding allocates only the per-call scheduling state.
+/// @tparam Bytes Size of the decoded buffers.
+template <size_t Bytes>
+class BatchDecoder {
+    public:
+        /// @brief Construct a decoder for the fields `fields`.
+        /// @throws std::invalid_argument if a field is not 1..64 bits wide.
+        /// @throws std::out_of_range if a field does not lie inside the buffer.
+        explicit BatchDecoder(const std::vector<BitRange>& fields) {
+            for (const BitRange& range : fields) {
+                uint64_t start = range.getStart().getBitIndex();
+                uint64_t end = range.getEnd().getBitIndex() + 1;
+                if (end <= start || end - start > 64) {
+                    throw std::invalid_argument("BatchDecoder: field must be 1..64 bits wide");
+                }
+                if (end > static_cast<uint64_t>(Bytes) * bitPerByte) {
+                    throw std::out_of_range("BatchDecoder: field exceeds the buffer");
+                }
+                unsigned width = static_cast<unsigned>(end - start);
+                refs.push_back(FieldRef{start, width});
+                maxWidth = std::max(maxWidth, width);
+            }
+        }
+
+        /// @brief Return the number of fields (output columns).
+        size_t fieldCount() const { return refs.size(); }
+
+        /// @brief Decode `count` consecutive buffers into `columns`.
+        /// @param columns `fieldCount()` arrays of at least `count` values each.
+        /// @param threshold Batches smaller than this many input bytes are decoded on the calling thread.
+        /// @throws std::invalid_argument if a field is wider than `T`.
+        template <typename T>
+        void decode(ThreadPool& pool, const ByteBuffer<Bytes>* records, size_t count, T* const* columns,
+                    size_t threshold = defaultParallelThreshold) const {
+            run(pool, count, columns, threshold, [records](size_t i) { return records[i].getData(); });
+        }
+
+        /// @brief Decode the `count` buffers `records[0..count-1]` into `columns`.
+        /// @throws Like the array overload.
+        template <typename T>
+        void decode(ThreadPool& pool, const ByteBuffer<Bytes>* const* records, size_t count, T* const* columns,
+                    size_t threshold = defaultParallelThreshold) const {
+            run(pool, count, columns, threshold, [records](size_t i) { return records[i]->getData(); });
+        }
+
+    private:
+        struct FieldRef {
+            uint64_t start;
+            unsigned width;
+        };
+
+        template <typename T, typename Record>
+        void run(ThreadPool& pool, size_t count, T* const* columns, size_t threshold, Record record) const {
+            static_assert(std::is_integral<T>::value,"only integral types are allowed");
+            if (maxWidth > sizeof(T) * bitPerByte) {
+                throw std::invalid_argument("BatchDecoder: field wider than the column type");
+            }
+            size_t participants = pool.concurrency();
+            if (count * Bytes < threshold || participants == 1) {
+                decodeRange(columns, 0, count, record);
+                return;
+            }
+            uint32_t grain = static_cast<uint32_t>(std::max<size_t>(1, 16384 / (Bytes + refs.size() * sizeof(T))));
+            const size_t slice = 0xffffffffu;
+            for (size_t base = 0; base < count; base += slice) {
+                size_t n = std::min(slice, count - base);
+                detail::StealingRanges ranges(static_cast<uint32_t>(n), participants, grain);
+                pool.parallelFor(participants, [&](size_t self) {
+                    size_t b;
+                    size_t e;
+                    while (ranges.next(self, b, e)) {
+                        decodeRange(columns, base + b, base + e, record);
+                    }
+                });
+            }
+        }
+
+        template <typename T, typename Record>
+        void decodeRange(T* const* columns, size_t begin, size_t end, Record record) const {
+            for (size_t i = begin; i < end; i++) {
+                const uint8_t* p = record(i);
+                for (size_t f = 0; f < refs.size(); f++) {
+                    columns[f][i] = static_cast<T>(extract(p, refs[f]));
+                }
+            }
+        }
+
+        static uint64_t extract(const uint8_t* p, const FieldRef& f) {
+            return detail::readField(p, Bytes, f.start, f.width);
+        }
+
+        std::vector<FieldRef> refs;
+        unsigned maxWidth = 0;
+};
+
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "ByteBuffer.hpp"
+#include "ByteBufferView.hpp"
+
+/// @file
+/// @brief Lazily evaluated bitwise expressions over whole buffers.
+/// @details `&`, `|`, `^`, `~` and `andNot` on buffers, views and expressions build an expression
+/// tree instead of computing a temporary per step. The tree is evaluated in a single loop (32
+/// bytes per step with AVX2, 8 bytes otherwise) when it is assigned to a `ByteBuffer`, written
+/// with `assign` or reduced with `popcount`, `any` or `none`, so every operand is read once and
+/// the result written once. An expression refers to its operand buffers, which must outlive it.
+/// Its length is the common length of the operands.
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief CRTP base of the expression nodes providing the single-pass evaluation.
+template <typename E>
+struct BitExpr : BitExpressionTag {
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    /// @brief Write the value of the expression to `out`, at most `n` bytes.
+    /// @return Number of bytes written.
+    size_t evaluateInto(uint8_t* out, size_t n) const {
+        const E& e = self();
+        n = n < e.size() ? n : e.size();
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 32 <= n; i += 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), e.vec(i));
+        }
+#endif
+        for (; i + 8 <= n; i += 8) {
+            uint64_t w = e.word(i);
+            std::memcpy(out + i, &w, sizeof(w));
+        }
+        for (; i < n; i++) {
+            out[i] = e.byte(i);
+        }
+        return n;
+    }
+};
+
+/// @brief Expression leaf reading the bytes of a buffer.
+struct BitLeaf : BitExpr<BitLeaf> {
+    explicit BitLeaf(ConstByteBufferView v) : ptr(v.data()), count(v.size()) {}
+
+    size_t size() const { return count; }
+    uint8_t byte(size_t i) const { return ptr[i]; }
+    uint64_t word(size_t i) const {
+        uint64_t w;
+        std::memcpy(&w, ptr + i, sizeof(w));
+        return w;
+    }
+#if defined(__AVX2__)
+    __m256i vec(size_t i) const { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i)); }
+#endif
+
+    const uint8_t* ptr;
+    size_t count;
+};
+
+struct BitAnd {
+    template <typename T>
+    static T apply(T a, T b) { return static_cast<T>(a & b); }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+};
+
+struct BitOr {
+    template <typename T>
+    static T apply(T a, T b) { return static_cast<T>(a | b); }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+};
+
+struct BitXor {
+    template <typename T>
+    static T apply(T a, T b) { return static_cast<T>(a ^ b); }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif
+};
+
+struct BitAndNot {
+    template <typename T>
+    static T apply(T a, T b) { return static_cast<T>(a & ~b); }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif
+};
+
+/// @brief Expression node combining two operands with `Op`.
+template <typename Op, typename L, typename R>
+struct BitBinary : BitExpr<BitBinary<Op, L, R>> {
+    BitBinary(const L& l, const R& r) : lhs(l), rhs(r) {}
+
+    size_t size() const { return lhs.size() < rhs.size() ? lhs.size() : rhs.size(); }
+    uint8_t byte(size_t i) const { return Op::apply(lhs.byte(i), rhs.byte(i)); }
+    uint64_t word(size_t i) const { return Op::apply(lhs.word(i), rhs.word(i)); }
+#if defined(__AVX2__)
+    __m256i vec(size_t i) const { return Op::apply(lhs.vec(i), rhs.vec(i)); }
+#endif
+
+    L lhs;
+    R rhs;
+};
+
+/// @brief Expression node complementing its operand.
+template <typename A>
+struct BitNot : BitExpr<BitNot<A>> {
+    explicit BitNot(const A& a) : arg(a) {}
+
+    size_t size() const { return arg.size(); }
+    uint8_t byte(size_t i) const { return static_cast<uint8_t>(~arg.byte(i)); }
+    uint64_t word(size_t i) const { return ~arg.word(i); }
+#if defined(__AVX2__)
+    __m256i vec(size_t i) const { return _mm256_xor_si256(arg.vec(i), _mm256_set1_epi32(-1)); }
+#endif
+
+    A arg;
+};
+
+/// @brief Map an operand type to its expression node; empty for types that are no operands.
+template <typename T, typename = void>
+struct BitOperand {};
+
+template <typename E>
+struct BitOperand<E, typename std::enable_if<std::is_base_of<BitExpressionTag, E>::value>::type> {
+    using type = E;
+    static const E& make(const E& e) { return e; }
+};
+
+template <size_t Bytes>
+struct BitOperand<ByteBuffer<Bytes>, void> {
+    using type = BitLeaf;
+    static BitLeaf make(const ByteBuffer<Bytes>& b) { return BitLeaf(b); }
+};
+
+template <>
+struct BitOperand<ByteBufferView, void> {
+    using type = BitLeaf;
+    static BitLeaf make(ByteBufferView v) { return BitLeaf(v); }
+};
+
+template <>
+struct BitOperand<ConstByteBufferView, void> {
+    using type = BitLeaf;
+    static BitLeaf make(ConstByteBufferView v) { return BitLeaf(v); }
+};
+
+template <typename T>
+using BitOperandType = typename BitOperand<T>::type;
+
+template <typename Op, typename A, typename B>
+using BitBinaryType = BitBinary<Op, BitOperandType<A>, BitOperandType<B>>;
+
+template <typename Op, typename A, typename B>
+BitBinaryType<Op, A, B> makeBinary(const A& a, const B& b) {
+    return BitBinaryType<Op, A, B>(BitOperand<A>::make(a), BitOperand<B>::make(b));
+}
+
+#if defined(__AVX2__)
+/// @brief Population count of each 64-bit lane (nibble lookup plus horizontal byte sum).
+inline __m256i popcount64(__m256i x) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(x, low)),
+                                  _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi64(x, 4), low)));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+#endif
+
+}
+
+/// @brief Bitwise and of two buffers, views or expressions.
+template <typename A, typename B>
+detail::BitBinaryType<detail::BitAnd, A, B> operator&(const A& a, const B& b) {
+    return detail::makeBinary<detail::BitAnd>(a, b);
+}
+
+/// @brief Bitwise or of two buffers, views or expressions.
+template <typename A, typename B>
+detail::BitBinaryType<detail::BitOr, A, B> operator|(const A& a, const B& b) {
+    return detail::makeBinary<detail::BitOr>(a, b);
+}
+
+/// @brief Bitwise exclusive or of two buffers, views or expressions.
+template <typename A, typename B>
+detail::BitBinaryType<detail::BitXor, A, B> operator^(const A& a, const B& b) {
+    return detail::makeBinary<detail::BitXor>(a, b);
+}
+
+/// @brief `a & ~b` of two buffers, views or expressions, without a separate complement step.
+template <typename A, typename B>
+detail::BitBinaryType<detail::BitAndNot, A, B> andNot(const A& a, const B& b) {
+    return detail::makeBinary<detail::BitAndNot>(a, b);
+}
+
+/// @brief Bitwise complement of a buffer, view or expression.
+template <typename A>
+detail::BitNot<detail::BitOperandType<A>> operator~(const A& a) {
+    return detail::BitNot<detail::BitOperandType<A>>(detail::BitOperand<A>::make(a));
+}
+
+/// @brief Evaluate `e` into `dst` in a single pass; only the common length is written.
+/// @details `dst` may be an operand of `e`.
+/// @return Number of bytes written.
+template <typename E, typename = typename detail::BitOperand<E>::type>
+size_t assign(ByteBufferView dst, const E& e) {
+    return detail::BitOperand<E>::make(e).evaluateInto(dst.data(), dst.size());
+}
+
+/// @brief Count the set bits of the expression `e` without materializing it.
+template <typename E, typename std::enable_if<std::is_base_of<BitExpressionTag, E>::value, int>::type = 0>
+uint64_t popcount(const E& e) {
+    size_t n = e.size();
+    size_t i = 0;
+    uint64_t cnt = 0;
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        acc = _mm256_add_epi64(acc, detail::popcount64(e.vec(i)));
+    }
+    cnt += static_cast<uint64_t>(_mm256_extract_epi64(acc, 0)) + static_cast<uint64_t>(_mm256_extract_epi64(acc, 1)) +
+           static_cast<uint64_t>(_mm256_extract_epi64(acc, 2)) + static_cast<uint64_t>(_mm256_extract_epi64(acc, 3));
+#endif
+    for (; i + 8 <= n; i += 8) {
+        cnt += static_cast<uint64_t>(__builtin_popcountll(e.word(i)));
+    }
+    for (; i < n; i++) {
+        cnt += static_cast<uint64_t>(__builtin_popcount(e.byte(i)));
+    }
+    return cnt;
+}
+
+/// @brief Return whether any bit of `e` is set; stops at the first non-zero block.
+template <typename E, typename = typename detail::BitOperand<E>::type>
+bool any(const E& e) {
+    const auto& x = detail::BitOperand<E>::make(e);
+    size_t n = x.size();
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = x.vec(i);
+        if (!_mm256_testz_si256(v, v)) {
+            return true;
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        if (x.word(i) != 0) {
+            return true;
+        }
+    }
+    for (; i < n; i++) {
+        if (x.byte(i) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Return whether no bit of `e` is set.
+template <typename E, typename = typename detail::BitOperand<E>::type>
+bool none(const E& e) {
+    return !any(e);
+}
+
+}
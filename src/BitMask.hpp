@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "Endian.hpp"
+
+/// @file
+/// @brief Compile-time mask and shift tables for bit fields and the field read/write primitives built on them.
+/// @details A field of `width` bits (1..64) starting at bit offset `o` (0..7) of its first byte covers
+/// `span[o][width]` bytes. The tables give the bits of the first and last byte that belong to the field and
+/// the shift aligning the last byte with the field value, so accesses touch whole bytes or words instead of
+/// stepping a position bit by bit. Bit order is LSB first, as everywhere in `ByteBuffer`.
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief Masks and shifts for every (bit offset, width) pair, built at compile time.
+struct BitMaskTables {
+    uint8_t span[8][65];        ///< Number of bytes covered by the field.
+    uint8_t firstMask[8][65];   ///< Field bits within the first byte.
+    uint8_t lastMask[8][65];    ///< Field bits within the last byte (the first byte if the span is 1).
+    uint8_t lastShift[8][65];   ///< Left shift of the last byte's bits within the field value.
+    uint64_t lowMask[65];       ///< The lowest `width` bits set.
+
+    constexpr BitMaskTables() : span(), firstMask(), lastMask(), lastShift(), lowMask() {
+        for (int w = 0; w <= 64; w++) {
+            lowMask[w] = w == 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << w) - 1;
+        }
+        for (int o = 0; o < 8; o++) {
+            for (int w = 1; w <= 64; w++) {
+                int n = (o + w + 7) / 8;
+                int inFirst = w < 8 - o ? w : 8 - o;
+                span[o][w] = static_cast<uint8_t>(n);
+                firstMask[o][w] = static_cast<uint8_t>(((1 << inFirst) - 1) << o);
+                if (n == 1) {
+                    lastMask[o][w] = firstMask[o][w];
+                } else {
+                    lastMask[o][w] = static_cast<uint8_t>((1 << (o + w - 8 * (n - 1))) - 1);
+                    lastShift[o][w] = static_cast<uint8_t>(8 * (n - 1) - o);
+                }
+            }
+        }
+    }
+};
+
+inline const BitMaskTables& bitMaskTables() {
+    static constexpr BitMaskTables tables{};
+    return tables;
+}
+
+/// @brief Return the `width` bits (1..64) at absolute bit `bit` of the `size` bytes at `p`.
+/// @details The field must lie inside the buffer. Bytes outside the field's span are not read,
+/// except that a whole little-endian 64-bit word is loaded when eight bytes are available.
+inline uint64_t readField(const uint8_t* p, size_t size, uint64_t bit, unsigned width) {
+    const BitMaskTables& t = bitMaskTables();
+    size_t first = static_cast<size_t>(bit >> 3);
+    unsigned o = static_cast<unsigned>(bit & 7);
+    const uint8_t* q = p + first;
+    unsigned n = t.span[o][width];
+    if (first + 8 <= size) {
+        uint64_t v = loadLe64(q) >> o;
+        if (n > 8) {
+            v |= static_cast<uint64_t>(q[8] & t.lastMask[o][width]) << t.lastShift[o][width];
+        }
+        return v & t.lowMask[width];
+    }
+    uint64_t v = static_cast<uint64_t>(q[0] & t.firstMask[o][width]) >> o;
+    if (n > 1) {
+        for (unsigned k = 1; k + 1 < n; k++) {
+            v |= static_cast<uint64_t>(q[k]) << (8 * k - o);
+        }
+        v |= static_cast<uint64_t>(q[n - 1] & t.lastMask[o][width]) << t.lastShift[o][width];
+    }
+    return v;
+}
+
+/// @brief Write the low `width` bits (1..64) of `value` at absolute bit `bit` of the `size` bytes at `p`.
+/// @details The field must lie inside the buffer. Bits outside the field keep their value. Only the
+/// bytes covered by the field are stored, so an update of other bytes of the buffer is never
+/// overwritten with stale contents; up to eight bytes may still be loaded.
+inline void writeField(uint8_t* p, size_t size, uint64_t bit, uint64_t value, unsigned width) {
+    const BitMaskTables& t = bitMaskTables();
+    size_t first = static_cast<size_t>(bit >> 3);
+    unsigned o = static_cast<unsigned>(bit & 7);
+    uint8_t* q = p + first;
+    unsigned n = t.span[o][width];
+    uint8_t last = t.lastMask[o][width];
+    if (first + 8 <= size) {
+        uint64_t w = loadLe64(q);
+        uint64_t m = t.lowMask[width] << o;
+        w = (w & ~m) | ((value << o) & m);
+        if (n < 8) {
+            storeLePartial(q, w, n);
+            return;
+        }
+        storeLe64(q, w);
+        if (n > 8) {
+            q[8] = static_cast<uint8_t>((q[8] & ~last) | (static_cast<uint8_t>(value >> t.lastShift[o][width]) & last));
+        }
+        return;
+    }
+    uint8_t firstMask = t.firstMask[o][width];
+    q[0] = static_cast<uint8_t>((q[0] & ~firstMask) | (static_cast<uint8_t>(value << o) & firstMask));
+    if (n > 1) {
+        for (unsigned k = 1; k + 1 < n; k++) {
+            q[k] = static_cast<uint8_t>(value >> (8 * k - o));
+        }
+        q[n - 1] = static_cast<uint8_t>((q[n - 1] & ~last) | (static_cast<uint8_t>(value >> t.lastShift[o][width]) & last));
+    }
+}
+
+}
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ByteBufferView.hpp"
+#include "Endian.hpp"
+
+/// @file
+/// @brief Frame-of-reference and delta bit-packing of 32-bit integer sequences.
+/// @details A packed sequence starts with its value count (32 bits, little-endian) followed by
+/// blocks of `packBlockSize` values; a shorter last block is padded. Each block stores a 32-bit
+/// reference, a header byte and the block values in the minimal bit width `b` (0..32) given by
+/// the header's low six bits. The encoder picks per block whichever mode needs fewer bits:
+/// - frame of reference: the values minus the block minimum (the reference);
+/// - delta (header bit 7): the differences to the value four positions earlier (to the
+///   reference, the first value, for the first four), modulo 2^32. Sorted sequences such as
+///   timestamps need only the width of their gaps.
+///
+/// The `16 * b` payload bytes use the vertical layout of SIMD-BP128: value `i` belongs to lane
+/// `i % 4`, whose values are packed LSB-first into the little-endian 32-bit words `4 * k + i % 4`.
+/// Decoding thus unpacks four values per SSE2 step with shifts and masks, and restores them with one
+/// vector addition (of the reference, or of the previous four values for deltas).
+
+namespace ByteBuffer  {
+
+/// @brief Number of values per packed block.
+constexpr size_t packBlockSize = 128;
+
+/// @brief Upper bound of the packed size of `count` values in bytes.
+constexpr size_t maxPackedIntegerSize(size_t count) {
+    return 4 + (count + packBlockSize - 1) / packBlockSize * (5 + packBlockSize * 4);
+}
+
+namespace detail {
+
+constexpr uint8_t packDeltaFlag = 0x80;
+
+inline unsigned bitWidth(uint32_t v) {
+    return v == 0 ? 0u : 32u - static_cast<unsigned>(__builtin_clz(v));
+}
+
+/// @brief Pack the 128 values `d` with width `b` into `16 * b` bytes of vertical layout.
+inline void packLanes(const uint32_t* d, unsigned b, uint8_t* out) {
+    uint32_t words[packBlockSize];
+    std::memset(words, 0, 16 * b);
+    for (size_t i = 0; i < packBlockSize && b != 0; i++) {
+        size_t bit = i / 4 * b;
+        size_t k = bit / 32;
+        size_t s = bit % 32;
+        words[k * 4 + i % 4] |= d[i] << s;
+        if (s + b > 32) {
+            words[(k + 1) * 4 + i % 4] |= d[i] >> (32 - s);
+        }
+    }
+    for (size_t k = 0; k < 4 * b; k++) {
+        storeLe32(out + k * 4, words[k]);
+    }
+}
+
+/// @brief Unpack 128 values of width `B` and add the reference (`Delta` false) or the previous four values.
+template <unsigned B, bool Delta>
+void unpackLanes(const uint8_t* in, uint32_t ref, uint32_t* out) {
+#if defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>((static_cast<uint64_t>(1) << B) - 1)));
+    __m128i base = _mm_set1_epi32(static_cast<int>(ref));
+    __m128i cur = B == 0 ? _mm_setzero_si128() : _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    size_t k = 0;
+    for (unsigned j = 0; j < 32; j++) {
+        const unsigned s = j * B % 32;
+        __m128i v = _mm_srl_epi32(cur, _mm_cvtsi32_si128(static_cast<int>(s)));
+        if (B != 0 && s + B >= 32 && j != 31) {
+            cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + ++k);
+            if (s + B > 32) {
+                v = _mm_or_si128(v, _mm_sll_epi32(cur, _mm_cvtsi32_si128(static_cast<int>(32 - s))));
+            }
+        }
+        v = _mm_add_epi32(_mm_and_si128(v, mask), base);
+        if (Delta) {
+            base = v;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j * 4), v);
+    }
+#else
+    const uint32_t mask = static_cast<uint32_t>((static_cast<uint64_t>(1) << B) - 1);
+    uint32_t base[4] = {ref, ref, ref, ref};
+    for (size_t i = 0; i < packBlockSize; i++) {
+        uint32_t v = 0;
+        if (B != 0) {
+            size_t bit = i / 4 * B;
+            size_t k = bit / 32;
+            size_t s = bit % 32;
+            v = loadLe32(in + (k * 4 + i % 4) * 4) >> s;
+            if (s + B > 32) {
+                v |= loadLe32(in + ((k + 1) * 4 + i % 4) * 4) << (32 - s);
+            }
+        }
+        out[i] = (v & mask) + base[i % 4];
+        if (Delta) {
+            base[i % 4] = out[i];
+        }
+    }
+#endif
+}
+
+using UnpackFunction = void (*)(const uint8_t*, uint32_t, uint32_t*);
+
+template <bool Delta, size_t... B>
+const UnpackFunction* unpackTable(std::index_sequence<B...>) {
+    static const UnpackFunction table[] = {&unpackLanes<static_cast<unsigned>(B), Delta>...};
+    return table;
+}
+
+/// @brief Return the block decoder for width `b` (0..32), specialized per width.
+inline UnpackFunction unpackFunction(unsigned b, bool delta) {
+    return delta ? unpackTable<true>(std::make_index_sequence<33>())[b] : unpackTable<false>(std::make_index_sequence<33>())[b];
+}
+
+}
+
+/// @brief Pack `count` values into `out`; see the file description for the format.
+/// @return Number of bytes written, or 0 if `out` is too small (`maxPackedIntegerSize` always suffices).
+inline size_t packIntegers(ByteBufferView out, const uint32_t* values, size_t count) {
+    if (out.size() < 4 || count > UINT32_MAX) {
+        return 0;
+    }
+    uint8_t* p = out.data();
+    detail::storeLe32(p, static_cast<uint32_t>(count));
+    size_t used = 4;
+    uint32_t block[packBlockSize];
+    uint32_t offsets[packBlockSize];
+    uint32_t deltas[packBlockSize];
+    for (size_t base = 0; base < count; base += packBlockSize) {
+        size_t n = count - base < packBlockSize ? count - base : packBlockSize;
+        std::memcpy(block, values + base, n * sizeof(uint32_t));
+        for (size_t i = n; i < packBlockSize; i++) {
+            block[i] = i < 4 ? block[0] : block[i - 4];
+        }
+        uint32_t lo = block[0];
+        uint32_t hi = block[0];
+        for (size_t i = 1; i < packBlockSize; i++) {
+            lo = block[i] < lo ? block[i] : lo;
+            hi = block[i] > hi ? block[i] : hi;
+        }
+        uint32_t deltaBits = 0;
+        for (size_t i = 0; i < packBlockSize; i++) {
+            offsets[i] = block[i] - lo;
+            deltas[i] = block[i] - (i < 4 ? block[0] : block[i - 4]);
+            deltaBits |= deltas[i];
+        }
+        unsigned forWidth = detail::bitWidth(hi - lo);
+        unsigned deltaWidth = detail::bitWidth(deltaBits);
+        bool delta = deltaWidth < forWidth;
+        unsigned b = delta ? deltaWidth : forWidth;
+        if (out.size() - used < 5 + 16 * static_cast<size_t>(b)) {
+            return 0;
+        }
+        detail::storeLe32(p + used, delta ? block[0] : lo);
+        p[used + 4] = static_cast<uint8_t>(b | (delta ? detail::packDeltaFlag : 0));
+        detail::packLanes(delta ? deltas : offsets, b, p + used + 5);
+        used += 5 + 16 * static_cast<size_t>(b);
+    }
+    return used;
+}
+
+/// @brief Return the value count of the packed sequence in `in`, or 0 if `in` holds no header.
+inline size_t packedIntegerCount(ConstByteBufferView in) {
+    return in.size() < 4 ? 0 : detail::loadLe32(in.data());
+}
+
+/// @brief Unpack the sequence in `in` into `out`.
+/// @param capacity Number of values `out` can hold; must be at least `packedIntegerCount(in)`.
+/// @return false if `out` is too small or `in` is truncated or malformed.
+inline bool unpackIntegers(ConstByteBufferView in, uint32_t* out, size_t capacity) {
+    if (in.size() < 4) {
+        return false;
+    }
+    size_t count = packedIntegerCount(in);
+    if (count > capacity) {
+        return false;
+    }
+    const uint8_t* p = in.data();
+    size_t used = 4;
+    uint32_t tail[packBlockSize];
+    for (size_t base = 0; base < count; base += packBlockSize) {
+        if (in.size() - used < 5) {
+            return false;
+        }
+        uint32_t ref = detail::loadLe32(p + used);
+        unsigned b = p[used + 4] & 0x3fu;
+        bool delta = (p[used + 4] & detail::packDeltaFlag) != 0;
+        if (b > 32 || in.size() - used - 5 < 16 * static_cast<size_t>(b)) {
+            return false;
+        }
+        size_t n = count - base < packBlockSize ? count - base : packBlockSize;
+        uint32_t* dst = n == packBlockSize ? out + base : tail;
+        detail::unpackFunction(b, delta)(p + used + 5, ref, dst);
+        if (dst == tail) {
+            std::memcpy(out + base, tail, n * sizeof(uint32_t));
+        }
+        used += 5 + 16 * static_cast<size_t>(b);
+    }
+    return true;
+}
+
+}
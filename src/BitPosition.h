@@ -33,6 +33,9 @@ class BitPosition
      /// @brief Get the byte index containing the bit.
      constexpr uint32_t getBytePos() const {return bytePos;}
 
+     /// @brief Get the absolute bit index (byte index * 8 + bit index).
+     constexpr uint64_t getBitIndex() const {return (static_cast<uint64_t>(bytePos) << 3) + bitPos;}
+
      // addition assignment operators
      
      /// @brief Add another BitPosition to this one (wraps bits into bytes).
@@ -40,13 +43,7 @@ class BitPosition
      /// @param rhs The right-hand-side added to `lhs`.
      /// @return Reference to modified `lhs`.
      friend BitPosition& operator+=(BitPosition& lhs, const BitPosition& rhs) {
-        lhs.bitPos += rhs.bitPos;
-
-        // remove wrap around
-        lhs.bytePos += lhs.bitPos / bitPerByte;
-        lhs.bitPos %= bitPerByte;
-
-        lhs.bytePos += rhs.bytePos;
+        lhs.setBitIndex(lhs.getBitIndex() + rhs.getBitIndex());
         return lhs;
      }
      
@@ -55,14 +52,7 @@ class BitPosition
      /// @param rhs The number of bits to add.
      /// @return Reference to modified `lhs`.
      friend BitPosition& operator+=(BitPosition& lhs, const uint32_t rhs){
-
-        lhs.bitPos += rhs % bitPerByte;
-
-        // remove wrap around
-        lhs.bytePos += lhs.bitPos / bitPerByte;
-        lhs.bitPos %= bitPerByte;
-
-        lhs.bytePos += rhs/bitPerByte;    
+        lhs.setBitIndex(lhs.getBitIndex() + rhs);
         return lhs;
      } 
       
@@ -105,13 +95,11 @@ class BitPosition
      
      /// @brief Subtract another BitPosition from this one (handles borrow from bytes).
      friend BitPosition& operator-=(BitPosition& lhs, const BitPosition& rhs) {
-        lhs.bitPos -= rhs.bitPos;
-        if (lhs.bitPos > 7){
-            uint8_t bitDiff = static_cast<uint8_t>(maxBitPos - lhs.bitPos);
-            lhs.bitPos = bitPerByte - bitDiff % bitPerByte;
-            lhs.bytePos -= 1 + bitDiff / bitPerByte;
-        }
-        lhs.bytePos -= rhs.bytePos;
+        // a bit difference that wrapped around maxBitPos is a borrow of whole bytes
+        int32_t bitDiff = static_cast<uint8_t>(lhs.bitPos - rhs.bitPos);
+        bitDiff -= static_cast<int32_t>(bitDiff > 7) * maxBitPos;
+        uint64_t byteDiff = static_cast<uint64_t>(lhs.bytePos) - rhs.bytePos;
+        lhs.setBitIndex((byteDiff << 3) + static_cast<uint64_t>(static_cast<int64_t>(bitDiff)));
         return lhs;
      } 
 
@@ -143,7 +131,7 @@ class BitPosition
 
      /// @brief Equality comparison.
      friend bool operator==(const BitPosition& lhs, const BitPosition& rhs){
-        return std::tie(lhs.bitPos,lhs.bytePos) == std::tie(rhs.bitPos,rhs.bytePos);
+        return lhs.orderKey() == rhs.orderKey();
      }
 
      /// @brief Inequality comparison.
@@ -153,12 +141,12 @@ class BitPosition
 
      /// @brief Greater-than comparison.
      friend bool operator>(const BitPosition& lhs, const BitPosition& rhs){
-        return lhs.bytePos > rhs.bytePos || (lhs.bytePos == rhs.bytePos && lhs.bitPos > rhs.bitPos);
+        return lhs.orderKey() > rhs.orderKey();
      }
 
      /// @brief Less-than comparison.
      friend bool operator<(const BitPosition& lhs, const BitPosition& rhs){
-        return lhs.bytePos < rhs.bytePos || (lhs.bytePos == rhs.bytePos && lhs.bitPos < rhs.bitPos);
+        return lhs.orderKey() < rhs.orderKey();
      }
 
      /// @brief Less-than-or-equal comparison.
@@ -171,6 +159,15 @@ class BitPosition
         return os << (int)(obj.bytePos) << "." << (int)(obj.bitPos);
      }
  private:
+     /// @brief Store the absolute bit index `index`; bytes wrap around modulo 2^32.
+     void setBitIndex(uint64_t index) {
+        bytePos = static_cast<uint32_t>(index >> 3);
+        bitPos = static_cast<uint8_t>(index & 7);
+     }
+
+     /// @brief Key ordering positions by byte, then bit, in a single comparison.
+     constexpr uint64_t orderKey() const {return (static_cast<uint64_t>(bytePos) << 8) | bitPos;}
+
      uint8_t bitPos;
      uint32_t bytePos;
 
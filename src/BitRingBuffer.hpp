@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "ByteBuffer.hpp"
+#include "Endian.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Single-producer/single-consumer ring buffer of bits for continuous stream decoding.
+/// @details The producer appends whole bytes or words; the consumer reads fields of up to 64 bits
+/// that may cross the wrap point, using the same LSB-first bit order as `ByteBuffer`. One producer
+/// thread and one consumer thread may use the buffer concurrently without locks; neither side ever
+/// moves data. A byte becomes writable again once all of its bits have been consumed.
+/// @tparam Bytes Capacity in bytes; must be a power of two.
+template <size_t Bytes>
+class BitRingBuffer {
+        static_assert(Bytes != 0 && (Bytes & (Bytes - 1)) == 0, "capacity must be a power of two");
+
+    public:
+        /// @brief Construct an empty ring buffer.
+        BitRingBuffer() = default;
+
+        BitRingBuffer(const BitRingBuffer&) = delete;
+        BitRingBuffer& operator=(const BitRingBuffer&) = delete;
+
+        /// @brief Return the capacity in bytes.
+        constexpr size_t capacity() const { return Bytes; }
+
+        // producer side
+
+        /// @brief Return the number of bytes the producer can append right now.
+        size_t writableBytes() {
+            producerTail = readBits.load(std::memory_order_acquire);
+            return static_cast<size_t>(Bytes - (writeBytes.load(std::memory_order_relaxed) - producerTail / bitPerByte));
+        }
+
+        /// @brief Append up to `count` bytes from `data`.
+        /// @return Number of bytes appended; less than `count` if the buffer is full.
+        size_t push(const uint8_t* data, size_t count) {
+            uint64_t head = writeBytes.load(std::memory_order_relaxed);
+            size_t free = static_cast<size_t>(Bytes - (head - producerTail / bitPerByte));
+            if (free < count) {
+                producerTail = readBits.load(std::memory_order_acquire);
+                free = static_cast<size_t>(Bytes - (head - producerTail / bitPerByte));
+            }
+            if (count > free) {
+                count = free;
+            }
+            size_t idx = static_cast<size_t>(head & (Bytes - 1));
+            size_t first = count < Bytes - idx ? count : Bytes - idx;
+            std::memcpy(buf.data() + idx, data, first);
+            std::memcpy(buf.data(), data + first, count - first);
+            writeBytes.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /// @brief Append a single byte.
+        /// @return False if the buffer is full.
+        bool push(uint8_t byte) {
+            return push(&byte, 1) == 1;
+        }
+
+        /// @brief Append all bytes of `value`, least-significant byte first.
+        /// @return False (and nothing appended) if fewer than `sizeof(N)` bytes are free.
+        template <typename N>
+        bool pushWord(N value) {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            uint8_t bytes[sizeof(N)];
+            for (size_t i = 0; i < sizeof(N); i++) {
+                bytes[i] = static_cast<uint8_t>(value >> (i * bitPerByte));
+            }
+            if (writableBytes() < sizeof(N)) {
+                return false;
+            }
+            push(bytes, sizeof(N));
+            return true;
+        }
+
+        // consumer side
+
+        /// @brief Return the number of bits the consumer can read right now.
+        uint64_t availableBits() {
+            consumerHead = writeBytes.load(std::memory_order_acquire);
+            return consumerHead * bitPerByte - readBits.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Read the next `bitCount` bits without consuming them.
+        /// @tparam N Integral return type; `bitCount` is limited to its width.
+        /// @return False (and `out` unchanged) if fewer than `bitCount` bits are available.
+        template <typename N>
+        bool peek(N& out, uint8_t bitCount) {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            if (bitCount > sizeof(N) * bitPerByte) {
+                bitCount = sizeof(N) * bitPerByte;
+            }
+            uint64_t tail = readBits.load(std::memory_order_relaxed);
+            if (consumerHead * bitPerByte - tail < bitCount && availableBits() < bitCount) {
+                return false;
+            }
+            out = static_cast<N>(extract(tail, bitCount));
+            return true;
+        }
+
+        /// @brief Read and consume the next `bitCount` bits, LSB first.
+        /// @tparam N Integral return type; `bitCount` is limited to its width.
+        /// @return False (and nothing consumed) if fewer than `bitCount` bits are available.
+        template <typename N>
+        bool read(N& out, uint8_t bitCount) {
+            if (bitCount > sizeof(N) * bitPerByte) {
+                bitCount = sizeof(N) * bitPerByte;
+            }
+            if (!peek(out, bitCount)) {
+                return false;
+            }
+            readBits.store(readBits.load(std::memory_order_relaxed) + bitCount, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Consume `bits` bits without reading them.
+        /// @return False (and nothing consumed) if fewer than `bits` bits are available.
+        bool skip(uint64_t bits) {
+            if (availableBits() < bits) {
+                return false;
+            }
+            readBits.store(readBits.load(std::memory_order_relaxed) + bits, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        /// @brief Gather `bitCount` (<= 64) bits starting at absolute bit `tail`, across the wrap point.
+        uint64_t extract(uint64_t tail, uint8_t bitCount) const {
+            if (bitCount == 0) {
+                return 0;
+            }
+            uint8_t shift = static_cast<uint8_t>(tail % bitPerByte);
+            size_t idx = static_cast<size_t>((tail / bitPerByte) & (Bytes - 1));
+            size_t n = (shift + bitCount + bitPerByte - 1) / bitPerByte;
+            uint8_t tmp[9] = {0};
+            size_t first = n < Bytes - idx ? n : Bytes - idx;
+            std::memcpy(tmp, buf.data() + idx, first);
+            std::memcpy(tmp + first, buf.data(), n - first);
+            uint64_t lo = detail::loadLe64(tmp);
+            uint64_t v = shift == 0 ? lo : (lo >> shift) | (static_cast<uint64_t>(tmp[8]) << (64 - shift));
+            return bitCount >= 64 ? v : v & ((static_cast<uint64_t>(1) << bitCount) - 1);
+        }
+
+        std::array<uint8_t, Bytes> buf{};
+        // producer-owned line: total bytes written plus the producer's view of the consumer
+        alignas(cacheLineSize) std::atomic<uint64_t> writeBytes{0};
+        uint64_t producerTail = 0;
+        // consumer-owned line: total bits read plus the consumer's view of the producer
+        alignas(cacheLineSize) std::atomic<uint64_t> readBits{0};
+        uint64_t consumerHead = 0;
+};
+
+}
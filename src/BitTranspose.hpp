@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__SSSE3__) || defined(__GFNI__)
+#include <immintrin.h>
+#endif
+
+#include "ByteBufferView.hpp"
+#include "Endian.hpp"
+
+/// @file
+/// @brief Bit-matrix transposes and bit reversal.
+/// @details A square matrix of `W` x `W` bits is stored as `W` rows of `W / 8` bytes; element
+/// (r, c) is bit `c` of row `r` in the LSB-first order of `ByteBuffer`, i.e. absolute bit
+/// `r * W + c`. Transposing moves element (r, c) to (c, r). All view functions may run in place
+/// (`dst` equal to `src`).
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief Per-byte bit reversal table, built at compile time.
+struct ReverseTable {
+    uint8_t rev[256];
+
+    constexpr ReverseTable() : rev() {
+        for (int i = 0; i < 256; i++) {
+            int r = 0;
+            for (int b = 0; b < 8; b++) {
+                r |= ((i >> b) & 1) << (7 - b);
+            }
+            rev[i] = static_cast<uint8_t>(r);
+        }
+    }
+};
+
+inline const ReverseTable& reverseTable() {
+    static constexpr ReverseTable table{};
+    return table;
+}
+
+/// @brief Transpose a square matrix of `sizeof(T) * 8` rows of type `T` in place.
+/// @details Recursive block swap: the off-diagonal halves of each 2j x 2j block are exchanged
+/// for j = W/2, W/4, ..., 1. With AVX2 the 64-bit rounds for j >= 4 swap four rows per step.
+template <typename T>
+void transposeRows(T* a) {
+    constexpr unsigned w = sizeof(T) * 8;
+    T m = static_cast<T>(static_cast<T>(~static_cast<T>(0)) >> (w / 2));
+    for (unsigned j = w / 2; j != 0; j >>= 1, m = static_cast<T>(m ^ static_cast<T>(m << j))) {
+        unsigned k = 0;
+#if defined(__AVX2__)
+        if (sizeof(T) == 8 && j >= 4) {
+            const __m256i vm = _mm256_set1_epi64x(static_cast<long long>(m));
+            const __m128i sh = _mm_cvtsi32_si128(static_cast<int>(j));
+            for (; k < w; k = ((k | j) + 4) & ~j) {
+                __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k));
+                __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + (k | j)));
+                __m256i t = _mm256_and_si256(_mm256_xor_si256(_mm256_srl_epi64(lo, sh), hi), vm);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + (k | j)), _mm256_xor_si256(hi, t));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + k), _mm256_xor_si256(lo, _mm256_sll_epi64(t, sh)));
+            }
+            continue;
+        }
+#endif
+        for (; k < w; k = ((k | j) + 1) & ~j) {
+            T t = static_cast<T>(((a[k] >> j) ^ a[k | j]) & m);
+            a[k | j] = static_cast<T>(a[k | j] ^ t);
+            a[k] = static_cast<T>(a[k] ^ static_cast<T>(t << j));
+        }
+    }
+}
+
+/// @brief Transpose every `Block`-byte block of `src` into `dst` with `kernel`; returns the block count.
+template <size_t Block, typename Kernel>
+size_t transposeBlocks(ConstByteBufferView src, ByteBufferView dst, Kernel kernel) {
+    size_t n = (src.size() < dst.size() ? src.size() : dst.size()) / Block;
+    for (size_t i = 0; i < n; i++) {
+        kernel(src.data() + i * Block, dst.data() + i * Block);
+    }
+    return n;
+}
+
+/// @brief Reverse the bits of each of the 16 bytes of `v`.
+#if defined(__GFNI__)
+inline __m128i reverseBytesBits(__m128i v) {
+    return _mm_gf2p8affine_epi64_epi8(v, _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ull)), 0);
+}
+#elif defined(__SSSE3__)
+inline __m128i reverseBytesBits(__m128i v) {
+    const __m128i lut = _mm_setr_epi8(0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf);
+    const __m128i low = _mm_set1_epi8(0x0f);
+    __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, low));
+    __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), low));
+    return _mm_or_si128(_mm_slli_epi16(lo, 4), hi);
+}
+#endif
+
+}
+
+/// @brief Transpose the 8x8 bit matrix held in `x` (row `r` is byte `r`).
+inline uint64_t transpose8x8(uint64_t x) {
+#if defined(__GFNI__)
+    // result byte j, bit i = parity(row(7 - i) of the matrix & (1 << j)) = bit j of input row i
+    __m128i m = _mm_cvtsi64_si128(static_cast<long long>(__builtin_bswap64(x)));
+    __m128i e = _mm_cvtsi64_si128(static_cast<long long>(0x8040201008040201ull));
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_gf2p8affine_epi64_epi8(e, m, 0)));
+#else
+    uint64_t t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaull;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000ccccull;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ull;
+    return x ^ t ^ (t << 28);
+#endif
+}
+
+/// @brief Transpose every 8-byte block (8x8 bits) of `src` into `dst`.
+/// @details Only the whole blocks of the common length are processed.
+/// @return Number of blocks transposed.
+inline size_t transpose8x8(ConstByteBufferView src, ByteBufferView dst) {
+    return detail::transposeBlocks<8>(src, dst, [](const uint8_t* in, uint8_t* out) {
+        detail::storeLe64(out, transpose8x8(detail::loadLe64(in)));
+    });
+}
+
+/// @brief Transpose every 32-byte block (16x16 bits, rows of two bytes) of `src` into `dst`.
+/// @details Only the whole blocks of the common length are processed.
+/// @return Number of blocks transposed.
+inline size_t transpose16x16(ConstByteBufferView src, ByteBufferView dst) {
+    return detail::transposeBlocks<32>(src, dst, [](const uint8_t* in, uint8_t* out) {
+        uint16_t rows[16];
+        for (size_t r = 0; r < 16; r++) {
+            rows[r] = detail::loadLe16(in + r * 2);
+        }
+        detail::transposeRows(rows);
+        for (size_t r = 0; r < 16; r++) {
+            detail::storeLe16(out + r * 2, rows[r]);
+        }
+    });
+}
+
+/// @brief Transpose every 512-byte block (64x64 bits, rows of eight bytes) of `src` into `dst`.
+/// @details Only the whole blocks of the common length are processed.
+/// @return Number of blocks transposed.
+inline size_t transpose64x64(ConstByteBufferView src, ByteBufferView dst) {
+    return detail::transposeBlocks<512>(src, dst, [](const uint8_t* in, uint8_t* out) {
+        uint64_t rows[64];
+        for (size_t r = 0; r < 64; r++) {
+            rows[r] = detail::loadLe64(in + r * 8);
+        }
+        detail::transposeRows(rows);
+        for (size_t r = 0; r < 64; r++) {
+            detail::storeLe64(out + r * 8, rows[r]);
+        }
+    });
+}
+
+/// @brief Reverse the bit order inside every byte of `v` (LSB-first <-> MSB-first layout).
+inline void reverseBitsInBytes(ByteBufferView v) {
+    uint8_t* p = v.data();
+    size_t i = 0;
+#if defined(__GFNI__) || defined(__SSSE3__)
+    for (; i + 16 <= v.size(); i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), detail::reverseBytesBits(x));
+    }
+#endif
+    const detail::ReverseTable& t = detail::reverseTable();
+    for (; i < v.size(); i++) {
+        p[i] = t.rev[p[i]];
+    }
+}
+
+/// @brief Reverse the whole buffer as one bit string: bit `i` and bit `size() * 8 - 1 - i` swap places.
+inline void reverseBits(ByteBufferView v) {
+    uint8_t* p = v.data();
+    size_t lo = 0;
+    size_t hi = v.size();
+#if defined(__SSSE3__)
+    const __m128i flip = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    for (; lo + 32 <= hi; lo += 16, hi -= 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + lo));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + hi - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + lo), detail::reverseBytesBits(_mm_shuffle_epi8(b, flip)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + hi - 16), detail::reverseBytesBits(_mm_shuffle_epi8(a, flip)));
+    }
+#endif
+    const detail::ReverseTable& t = detail::reverseTable();
+    for (; lo + 1 < hi; lo++, hi--) {
+        uint8_t a = p[lo];
+        p[lo] = t.rev[p[hi - 1]];
+        p[hi - 1] = t.rev[a];
+    }
+    if (lo + 1 == hi) {
+        p[lo] = t.rev[p[lo]];
+    }
+}
+
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "ByteBuffer.hpp"
+#include "ByteBufferView.hpp"
+#include "DynamicByteBuffer.hpp"
+#include "Endian.hpp"
+
+/// @file
+/// @brief Word-level conversion between buffers, `std::bitset`, `std::vector<bool>` and raw words.
+/// @details Bit `i` of a bitset or bool vector corresponds to bit `i` of the buffer in the LSB-first
+/// order of `ByteBuffer`, i.e. bit `i % 64` of word `i / 64` of the raw word representation.
+/// On little-endian hosts with libstdc++ or libc++ the bitset and bool vector storage is copied
+/// directly; other libraries and big-endian hosts go through `to_ullong()` chunks or single bits.
+
+// The direct copies rely on library internals:
+// - libstdc++ and libc++ store std::bitset<N> as nothing but an array of unsigned long
+//   (_M_w / __first_), bit i at bit i % W of word i / W; bitsetIsWordArray() checks the size.
+// - libstdc++ stores std::vector<bool> as an array of unsigned long (_Bit_type) whose first
+//   word is begin()._M_p, in the same bit order.
+// On a little-endian host the bytes of such an array are the buffer's bytes in LSB-first order.
+#if (defined(__GLIBCXX__) || defined(_LIBCPP_VERSION)) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BYTEBUFFER_BITSET_WORDS 1
+#endif
+#if defined(__GLIBCXX__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BYTEBUFFER_BOOLVECTOR_WORDS 1
+#endif
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+constexpr size_t wordCount(size_t bits) { return (bits + 63) / 64; }
+
+/// @brief Copy `bytes` bytes into `count` little-endian words, zero-padding the last word and any further words.
+inline size_t bytesToWords(const uint8_t* p, size_t bytes, uint64_t* words, size_t count) {
+    size_t n = bytes < count * 8 ? bytes : count * 8;
+    size_t used = wordCount(n * 8);
+    for (size_t i = 0; i < used; i++) {
+        words[i] = n - i * 8 >= 8 ? loadLe64(p + i * 8) : loadLePartial(p + i * 8, n - i * 8);
+    }
+    std::memset(words + used, 0, (count - used) * sizeof(uint64_t));
+    return used;
+}
+
+/// @brief Copy the first `bits` bits of the little-endian `words` into `p`; bits of the last byte beyond
+/// `bits` keep their value.
+inline void wordsToBytes(const uint64_t* words, size_t bits, uint8_t* p) {
+    size_t whole = bits / 8;
+    for (size_t i = 0; i * 8 < whole; i++) {
+        storeLePartial(p + i * 8, words[i], whole - i * 8 < 8 ? whole - i * 8 : 8);
+    }
+    if (bits % 8 != 0) {
+        uint8_t last = static_cast<uint8_t>(words[whole / 8] >> (whole % 8 * 8));
+        uint8_t m = static_cast<uint8_t>((1u << (bits % 8)) - 1);
+        p[whole] = static_cast<uint8_t>((p[whole] & ~m) | (last & m));
+    }
+}
+
+#if defined(BYTEBUFFER_BITSET_WORDS)
+template <size_t N>
+constexpr bool bitsetIsWordArray() {
+    return N != 0 && sizeof(std::bitset<N>) == ((N + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))) * sizeof(unsigned long);
+}
+#endif
+
+}
+
+/// @brief Copy the bits of `v` into `count` little-endian words; missing bits are zero.
+/// @return Number of words holding bits of `v`.
+inline size_t exportWords(ConstByteBufferView v, uint64_t* words, size_t count) {
+    return detail::bytesToWords(v.data(), v.size(), words, count);
+}
+
+/// @brief Copy `count` words into `v`; bits beyond `count * 64` keep their value.
+/// @return Number of words copied.
+inline size_t importWords(ByteBufferView v, const uint64_t* words, size_t count) {
+    size_t bits = count * 64 < v.size() * 8 ? count * 64 : v.size() * 8;
+    detail::wordsToBytes(words, bits, v.data());
+    return detail::wordCount(bits);
+}
+
+/// @brief Copy the bits of `b` into `count` words; missing bits are zero.
+/// @return Number of words holding bits of `b`.
+template <size_t N>
+size_t exportWords(const std::bitset<N>& b, uint64_t* words, size_t count) {
+#if defined(BYTEBUFFER_BITSET_WORDS)
+    if (detail::bitsetIsWordArray<N>()) {
+        return detail::bytesToWords(reinterpret_cast<const uint8_t*>(&b), (N + 7) / 8, words, count);
+    }
+#endif
+    size_t used = detail::wordCount(N) < count ? detail::wordCount(N) : count;
+    std::bitset<N> rest = b;
+    const std::bitset<N> low(~0ull);
+    for (size_t i = 0; i < used; i++, rest >>= 64) {
+        words[i] = (rest & low).to_ullong();
+    }
+    for (size_t i = used; i < count; i++) {
+        words[i] = 0;
+    }
+    return used;
+}
+
+/// @brief Replace the bits of `b` by the first `N` bits of `count` words; missing bits are zero.
+/// @return Number of words copied.
+template <size_t N>
+size_t importWords(std::bitset<N>& b, const uint64_t* words, size_t count) {
+    size_t used = detail::wordCount(N) < count ? detail::wordCount(N) : count;
+    b.reset();
+#if defined(BYTEBUFFER_BITSET_WORDS)
+    if (detail::bitsetIsWordArray<N>()) {
+        size_t bits = used * 64 < N ? used * 64 : N;
+        detail::wordsToBytes(words, bits, reinterpret_cast<uint8_t*>(&b));
+        return used;
+    }
+#endif
+    for (size_t i = used; i-- > 0;) {
+        b <<= 64;
+        b |= std::bitset<N>(words[i]);
+    }
+    return used;
+}
+
+/// @brief Return the first `N` bits of `v` as a bitset; bits beyond the view are zero.
+template <size_t N>
+std::bitset<N> toBitset(ConstByteBufferView v) {
+    std::vector<uint64_t> words(detail::wordCount(N));
+    exportWords(v, words.data(), words.size());
+    std::bitset<N> b;
+    importWords(b, words.data(), words.size());
+    return b;
+}
+
+/// @brief Copy the bits of `b` into `v`; bits of `v` beyond `N` keep their value.
+template <size_t N>
+void fromBitset(const std::bitset<N>& b, ByteBufferView v) {
+    std::vector<uint64_t> words(detail::wordCount(N));
+    exportWords(b, words.data(), words.size());
+    size_t bits = N < v.size() * 8 ? N : v.size() * 8;
+    detail::wordsToBytes(words.data(), bits, v.data());
+}
+
+/// @brief Return a buffer holding the bits of `b`; further bits are zero.
+template <size_t Bytes, size_t N>
+ByteBuffer<Bytes> makeByteBuffer(const std::bitset<N>& b) {
+    ByteBuffer<Bytes> buf;
+    fromBitset(b, buf);
+    return buf;
+}
+
+/// @brief Copy the bits of `v` into `count` words; missing bits are zero.
+/// @return Number of words holding bits of `v`.
+inline size_t exportWords(const std::vector<bool>& v, uint64_t* words, size_t count) {
+#if defined(BYTEBUFFER_BOOLVECTOR_WORDS)
+    // libstdc++ keeps the bits in an array of unsigned long starting at the begin iterator's word;
+    // bits of the last word beyond size() are unspecified and cleared here
+    size_t used = detail::bytesToWords(reinterpret_cast<const uint8_t*>(v.begin()._M_p), (v.size() + 7) / 8, words, count);
+    if (used * 64 > v.size() && v.size() % 64 != 0) {
+        words[used - 1] &= (static_cast<uint64_t>(1) << (v.size() % 64)) - 1;
+    }
+    return used;
+#else
+    size_t used = detail::wordCount(v.size()) < count ? detail::wordCount(v.size()) : count;
+    std::memset(words, 0, count * sizeof(uint64_t));
+    size_t bits = used * 64 < v.size() ? used * 64 : v.size();
+    for (size_t i = 0; i < bits; i++) {
+        words[i / 64] |= static_cast<uint64_t>(v[i]) << (i % 64);
+    }
+    return used;
+#endif
+}
+
+/// @brief Replace the bits of `v` (keeping its size) by the bits of `count` words; missing bits are zero.
+/// @return Number of words copied.
+inline size_t importWords(std::vector<bool>& v, const uint64_t* words, size_t count) {
+    size_t used = detail::wordCount(v.size()) < count ? detail::wordCount(v.size()) : count;
+    size_t bits = used * 64 < v.size() ? used * 64 : v.size();
+#if defined(BYTEBUFFER_BOOLVECTOR_WORDS)
+    std::fill(v.begin(), v.end(), false);
+    if (bits == 0) {
+        return used;
+    }
+    detail::wordsToBytes(words, bits, reinterpret_cast<uint8_t*>(v.begin()._M_p));
+#else
+    for (size_t i = 0; i < v.size(); i++) {
+        v[i] = i < bits && ((words[i / 64] >> (i % 64)) & 1);
+    }
+#endif
+    return used;
+}
+
+/// @brief Return the bits of `v` as a bool vector of `v.size() * 8` elements.
+inline std::vector<bool> toBoolVector(ConstByteBufferView v) {
+    std::vector<bool> out(v.size() * 8);
+    std::vector<uint64_t> words(detail::wordCount(out.size()));
+    exportWords(v, words.data(), words.size());
+    importWords(out, words.data(), words.size());
+    return out;
+}
+
+/// @brief Copy the bits of `b` into `v`; bits of `v` beyond `b.size()` keep their value.
+inline void fromBoolVector(const std::vector<bool>& b, ByteBufferView v) {
+    std::vector<uint64_t> words(detail::wordCount(b.size()));
+    exportWords(b, words.data(), words.size());
+    size_t bits = b.size() < v.size() * 8 ? b.size() : v.size() * 8;
+    detail::wordsToBytes(words.data(), bits, v.data());
+}
+
+/// @brief Return a growable buffer holding exactly the bits of `b` (`bitSize() == b.size()`).
+inline DynamicByteBuffer makeDynamicByteBuffer(const std::vector<bool>& b) {
+    DynamicByteBuffer out(b.size() / 8);
+    fromBoolVector(b, out);
+    if (b.size() % 8 != 0) {
+        uint8_t last = 0;
+        for (size_t i = b.size() / 8 * 8; i < b.size(); i++) {
+            last = static_cast<uint8_t>(last | (b[i] << (i % 8)));
+        }
+        out.append(last, static_cast<uint8_t>(b.size() % 8));
+    }
+    return out;
+}
+
+}
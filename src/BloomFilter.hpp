@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "ByteBuffer.hpp"
+#include "ByteBufferView.hpp"
+#include "Endian.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Bloom filter whose probes for a key all fall into one 64-byte block.
+/// @details The upper 32 bits of a key's hash select a block; the lower 32 bits, multiplied by
+/// eight odd salts, select one bit in each of the block's eight little-endian 64-bit words
+/// (k = 8). Inserting or testing a key therefore touches a single cache line and is done with
+/// one mask operation over the block (two 256-bit operations with AVX2). Batched operations prefetch the blocks of
+/// keys a few positions ahead. The bits live in a `ByteBuffer<Bytes>` and can be saved through
+/// `getData()` and restored with the view constructor, also on a host of the other byte order.
+/// @tparam Bytes Filter size; a non-zero multiple of 64.
+template <size_t Bytes>
+class BlockedBloomFilter {
+        static_assert(Bytes != 0 && Bytes % 64 == 0, "filter size must be a multiple of 64 bytes");
+
+    public:
+        /// @brief Number of 64-byte blocks.
+        static constexpr size_t blocks = Bytes / 64;
+
+        /// @brief Construct an empty filter.
+        BlockedBloomFilter() = default;
+
+        /// @brief Construct a filter from the bytes of a saved filter of the same size.
+        /// @details Only the common length is copied; missing bytes stay zero.
+        explicit BlockedBloomFilter(ConstByteBufferView saved) {
+            std::memcpy(bits.data(), saved.data(), saved.size() < Bytes ? saved.size() : Bytes);
+        }
+
+        /// @brief Add the key with hash `hash`.
+        /// @note The hash must be well mixed in all 64 bits.
+        void insert(uint64_t hash) {
+            uint8_t* b = block(hash);
+#if defined(__AVX2__)
+            __m256i lo;
+            __m256i hi;
+            masks(hash, lo, hi);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(b), _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)), lo));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(b + 32), _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32)), hi));
+#else
+            uint64_t m[8];
+            masks(hash, m);
+            for (size_t i = 0; i < 8; i++) {
+                detail::storeLe64(b + i * 8, detail::loadLe64(b + i * 8) | m[i]);
+            }
+#endif
+        }
+
+        /// @brief Return whether the key with hash `hash` may have been added.
+        /// @details False positives are possible, false negatives are not.
+        bool contains(uint64_t hash) const {
+            const uint8_t* b = block(hash);
+#if defined(__AVX2__)
+            __m256i lo;
+            __m256i hi;
+            masks(hash, lo, hi);
+            __m256i missLo = _mm256_andnot_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)), lo);
+            __m256i missHi = _mm256_andnot_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32)), hi);
+            __m256i miss = _mm256_or_si256(missLo, missHi);
+            return _mm256_testz_si256(miss, miss) != 0;
+#else
+            uint64_t m[8];
+            masks(hash, m);
+            uint64_t miss = 0;
+            for (size_t i = 0; i < 8; i++) {
+                miss |= m[i] & ~detail::loadLe64(b + i * 8);
+            }
+            return miss == 0;
+#endif
+        }
+
+        /// @brief Add `count` keys given by their hashes, prefetching blocks ahead.
+        void insertBatch(const uint64_t* hashes, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                if (i + prefetchDistance < count) {
+                    __builtin_prefetch(block(hashes[i + prefetchDistance]), 1);
+                }
+                insert(hashes[i]);
+            }
+        }
+
+        /// @brief Test `count` keys given by their hashes, prefetching blocks ahead.
+        /// @param bitmap Receives one bit per key (bit `i % 64` of word `i / 64`), set if the key
+        /// may be present; must hold `(count + 63) / 64` words.
+        /// @return Number of keys that may be present.
+        size_t containsBatch(const uint64_t* hashes, size_t count, uint64_t* bitmap) const {
+            size_t hits = 0;
+            for (size_t base = 0; base < count; base += 64) {
+                size_t n = count - base < 64 ? count - base : 64;
+                uint64_t word = 0;
+                for (size_t j = 0; j < n; j++) {
+                    size_t i = base + j;
+                    if (i + prefetchDistance < count) {
+                        __builtin_prefetch(block(hashes[i + prefetchDistance]));
+                    }
+                    word |= static_cast<uint64_t>(contains(hashes[i])) << j;
+                }
+                bitmap[base / 64] = word;
+                hits += static_cast<size_t>(__builtin_popcountll(word));
+            }
+            return hits;
+        }
+
+        /// @brief Remove all keys.
+        void clear() { bits.fill(0); }
+
+        /// @brief Return the filter size in bytes.
+        constexpr size_t size() const { return Bytes; }
+
+        /// @brief Return a pointer to the filter bits, e.g. for saving the filter.
+        const uint8_t* getData() const { return bits.getData(); }
+
+        /// @brief Return the buffer holding the filter bits.
+        const ByteBuffer<Bytes>& buffer() const { return bits; }
+
+    private:
+        static constexpr size_t prefetchDistance = 8;
+
+        uint8_t* block(uint64_t hash) {
+            return bits.data() + blockIndex(hash) * 64;
+        }
+
+        const uint8_t* block(uint64_t hash) const {
+            return bits.getData() + blockIndex(hash) * 64;
+        }
+
+        static size_t blockIndex(uint64_t hash) {
+            return static_cast<size_t>(((hash >> 32) * blocks) >> 32);
+        }
+
+#if defined(__AVX2__)
+        /// @brief Compute the probe masks of the eight block words.
+        static void masks(uint64_t hash, __m256i& lo, __m256i& hi) {
+            const __m256i salts = _mm256_setr_epi32(0x47b6137b, 0x44974d91, static_cast<int>(0x8824ad5bu), static_cast<int>(0xa2b7289du),
+                                                    0x705495c7, 0x2df1424b, static_cast<int>(0x9efc4947u), 0x5c6bfb31);
+            __m256i idx = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(hash))), salts), 26);
+            const __m256i one = _mm256_set1_epi64x(1);
+            lo = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(idx)));
+            hi = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(idx, 1)));
+        }
+#else
+        /// @brief Compute the probe masks of the eight block words.
+        static void masks(uint64_t hash, uint64_t* m) {
+            static const uint32_t salts[8] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                                              0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+            uint32_t h = static_cast<uint32_t>(hash);
+            for (size_t i = 0; i < 8; i++) {
+                m[i] = static_cast<uint64_t>(1) << ((h * salts[i]) >> 26);
+            }
+        }
+#endif
+
+        alignas(cacheLineSize) ByteBuffer<Bytes> bits;
+};
+
+}
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <ostream>
+#include <stdexcept>
 #include <functional>
+#include <type_traits>
 
+#include "BitMask.hpp"
 #include "BitRange.hpp"
+#include "Instrumentation.hpp"
 
 namespace ByteBuffer  {
 
+/// @brief Assumed size of a cache line in bytes.
+constexpr size_t cacheLineSize = 64;
+
 /// @brief Represents a count in bytes expressed as number of bits.
 /// @details Construct by passing a byte count; the member `bits` stores the equivalent
 /// number of bits (bytes * 8).
@@ -59,6 +67,19 @@ inline std::ostream& operator<<(std::ostream& os, const Bit& obj)
     return os << (obj.getter() ? "set" : "cleared");
 }
 
+/// @brief Tag type selecting the non-zeroing `ByteBuffer` constructor.
+/// @details Use `ByteBuffer<N> b(noInit);` when the contents are overwritten anyway
+/// (e.g. buffers recycled by a `ByteBufferPool`) and the `fill(0)` would be redundant.
+struct NoInit {};
+
+/// @brief Instance of the `NoInit` tag.
+constexpr NoInit noInit{};
+
+/// @brief Base of the lazily evaluated bitwise expressions in `BitExpression.hpp`.
+/// @details Declared here so `ByteBuffer` can be constructed from and assigned an expression
+/// without depending on the expression header.
+struct BitExpressionTag {};
+
 /// @brief Fixed-size byte buffer with bit-level access and helpers.
 /// @tparam Bytes Number of bytes stored in the buffer.
 template <size_t Bytes>
@@ -66,6 +87,27 @@ template <size_t Bytes>
         public:
             /// @brief Construct an empty buffer and zero-initialize its contents.
             ByteBuffer() { buf.fill(0); }
+
+            /// @brief Construct a buffer without initializing its contents.
+            /// @details The contents are unspecified until written by the caller.
+            explicit ByteBuffer(NoInit) {}
+
+            /// @brief Construct a buffer holding the value of the bitwise expression `e` (see `BitExpression.hpp`).
+            /// @details Bytes beyond the length of the expression are zero.
+            template <typename E, typename std::enable_if<std::is_base_of<BitExpressionTag, E>::value, int>::type = 0>
+            ByteBuffer(const E& e) {
+                size_t n = e.evaluateInto(buf.data(), Bytes);
+                std::fill(buf.begin() + static_cast<std::ptrdiff_t>(n), buf.end(), static_cast<uint8_t>(0));
+            }
+
+            /// @brief Evaluate the bitwise expression `e` into the buffer in a single pass.
+            /// @details Bytes beyond the length of the expression keep their value. The buffer may
+            /// itself be an operand of `e`.
+            template <typename E, typename std::enable_if<std::is_base_of<BitExpressionTag, E>::value, int>::type = 0>
+            ByteBuffer& operator=(const E& e) {
+                e.evaluateInto(buf.data(), Bytes);
+                return *this;
+            }
             
             ~ByteBuffer() = default;
         
@@ -81,42 +123,37 @@ template <size_t Bytes>
             void set(const BitPosition pos,N value,const uint8_t bitCount) {
             
                 static_assert(std::is_integral<N>::value,"only integral types are allowed");
-            
-                BitPosition _pos = pos;
-                BitPosition max = maxPosition<N>(pos,bitCount);      
 
-                uint8_t idx = 0;
-                while ( _pos < max )
+                unsigned width = fieldWidth<N>(pos,bitCount);
+                if (width != 0)
                 {
-                    uint8_t insert = static_cast<uint8_t>(value >> idx);
-                    set<N>(_pos,insert);
-                    _pos++;
-                    idx++;
+                    detail::writeField(buf.data(),Bytes,pos.getBitIndex(),static_cast<uint64_t>(value),width);
                 }
+                BYTEBUFFER_RECORD_SET(sizeof(N),pos,width);
             }
 
             /// @brief Insert bits of `value` into the buffer over the specified `range`.
-            /// @details The least-significant bits of `value` map to the start of `range`. If `range` extends beyond
-            /// the buffer or `value` has fewer bits than `range`, remaining positions are truncated.
+            /// @details The least-significant bits of `value` map to the start of `range`. If `value` has fewer bits
+            /// than `range`, the remaining positions receive its sign (zero for unsigned types).
             /// @tparam N Integral input type.
             /// @param range Bit range within the buffer.
             /// @param value Value supplying bits to be inserted.
+            /// @throws std::out_of_range if `range` extends beyond the buffer.
             template <typename N>
             void set(const BitRange range,N value) {
             
                 static_assert(std::is_integral<N>::value,"only integral types are allowed");
-                BitRange cur = range;
-                BitPosition _pos = cur.getStart();
-                BitPosition max =  cur.getEnd();//maxPosition<N>(pos,bitCount);      
 
-                uint8_t idx = 0;
-                while ( _pos <= max )
+                uint64_t start = range.getStart().getBitIndex();
+                uint64_t width = rangeWidth(range);
+                uint64_t raw = static_cast<uint64_t>(value);
+                uint64_t fill = std::is_signed<N>::value && (raw >> 63) != 0 ? ~static_cast<uint64_t>(0) : 0;
+                for (uint64_t done = 0; done < width; done += 64)
                 {
-                    uint8_t insert = static_cast<uint8_t>(value >> idx);
-                    set<N>(_pos,insert);
-                    _pos++;
-                    idx++;
+                    unsigned chunk = static_cast<unsigned>(width - done < 64 ? width - done : 64);
+                    detail::writeField(buf.data(),Bytes,start + done,done == 0 ? raw : fill,chunk);
                 }
+                BYTEBUFFER_RECORD_SET(sizeof(N),range.getStart(),static_cast<uint32_t>(width));
             }
 
         /// @brief Set or clear a single bit at `pos` according to the least-significant bit of `value`.
@@ -128,13 +165,8 @@ template <size_t Bytes>
 
             static_assert(std::is_integral<N>::value,"only integral types are allowed");
 
-            if ((value & 1) == 1)
-            {
-                set(pos);
-            }else 
-            {
-                reset(pos);
-            }
+            BYTEBUFFER_RECORD_SET(sizeof(N),pos,1);
+            setBit(pos,value);
         }
         
         /// @brief Retrieve up to `bitCount` bits starting at `pos`, packed into the return value from LSB upwards.
@@ -147,42 +179,33 @@ template <size_t Bytes>
 
             static_assert(std::is_integral<N>::value,"only integral types are allowed");
 
-            BitPosition _pos = pos;
-            BitPosition _end = maxPosition<N>(pos,bitCount);
-
-            N ret = 0;
-            uint8_t idx = 0;
-            while(_pos < _end)
+            unsigned width = fieldWidth<N>(pos,bitCount);
+            BYTEBUFFER_RECORD_GET(sizeof(N),pos,width);
+            if (width == 0)
             {
-                ret |= static_cast<N>(get<N>(_pos) << idx);
-                idx++;
-                _pos++;
+                return 0;
             }
-            return ret;
+            return static_cast<N>(detail::readField(buf.data(),Bytes,pos.getBitIndex(),width));
         }
 
         /// @brief Retrieve bits from `range` and return them packed in the lower bits of the result.
         /// @tparam N Integral return type.
         /// @param range Bit range within buffer.
-        /// @return Value containing bits from `range` in its lower bits.
+        /// @return Value containing bits from `range` in its lower bits; bits beyond the width of `N` are dropped.
+        /// @throws std::out_of_range if `range` extends beyond the buffer.
         template <typename N>
         N get(const BitRange range) {
             
             static_assert(std::is_integral<N>::value,"only integral types are allowed");
 
-            BitRange cur = range;
-            BitPosition _pos = cur.getStart();
-            BitPosition _end = cur.getEnd();//maxPosition<N>(range.start,range.end);
-
-            N ret = 0;
-            uint8_t idx = 0;
-            while(_pos <= _end)
+            uint64_t width = rangeWidth(range);
+            BYTEBUFFER_RECORD_GET(sizeof(N),range.getStart(),static_cast<uint32_t>(width));
+            if (width == 0)
             {
-                ret |= static_cast<N>(get<N>(_pos) << idx);
-                idx++;
-                _pos++;
+                return 0;
             }
-            return ret;
+            unsigned used = static_cast<unsigned>(width < 64 ? width : 64);
+            return static_cast<N>(detail::readField(buf.data(),Bytes,range.getStart().getBitIndex(),used));
         }
         
         /// @brief Return a `Bits` proxy bound to `range` (allows read/write of the whole range as an integer).
@@ -190,6 +213,7 @@ template <size_t Bytes>
             auto setter = [range,this](uint32_t value) { set<uint32_t>(range,value);};
             std::function<uint32_t(void)> getter = [range,this]() {return get<uint32_t>(range);};
             Bits ret( setter , getter );
+            BYTEBUFFER_RECORD_PROXY();
             return ret;
         }
 
@@ -203,6 +227,7 @@ template <size_t Bytes>
             auto setter = [pos,this](uint32_t value) { set<uint32_t>(pos,value);};
             std::function<uint32_t(void)> getter = [pos,this]() {return get<uint32_t>(pos);};
             Bit ret( setter , getter );
+            BYTEBUFFER_RECORD_PROXY();
             return ret;
         }
 
@@ -212,10 +237,9 @@ template <size_t Bytes>
         /// @return 0 or 1 in the LSB of the return value.
         template <typename N>
         N get(BitPosition pos) {
-            
-            N cont = buf.at(pos.getBytePos());
-            N cont_without = (cont >> pos.getBitPos());
-            return cont_without & 1;
+
+            BYTEBUFFER_RECORD_GET(sizeof(N),pos,1);
+            return getBit<N>(pos);
         } 
 
         /// @brief Fill the internal buffer with the byte pattern `val`.
@@ -224,14 +248,39 @@ template <size_t Bytes>
     
         /// @brief Return the number of bytes in the underlying buffer.
         /// @return size of the underlying array in bytes.
-        constexpr size_t size() {return buf.size();}
+        constexpr size_t size() const {return Bytes;}
 
         /// @brief Return a pointer to the internal data array.
         /// @note The caller should verify the number of bytes with `size()`.
         /// @return Pointer to the buffer's data.
-        const uint8_t* getData() {return buf.data();}
+        const uint8_t* getData() const {return buf.data();}
+
+        /// @brief Return a mutable pointer to the internal data array for bulk operations.
+        /// @note The caller should verify the number of bytes with `size()`.
+        /// @return Pointer to the buffer's data.
+        uint8_t* data() {return buf.data();}
     private:
-        
+
+        /// @brief Retrieve the single bit at `pos` in the LSB of the result.
+        template <typename N>
+        N getBit(BitPosition pos) {
+            N cont = buf.at(pos.getBytePos());
+            N cont_without = (cont >> pos.getBitPos());
+            return cont_without & 1;
+        }
+
+        /// @brief Set or clear the single bit at `pos` according to the LSB of `value`.
+        template <typename N>
+        void setBit(BitPosition pos, const N value) {
+            if ((value & 1) == 1)
+            {
+                set(pos);
+            }else 
+            {
+                reset(pos);
+            }
+        }
+
         /// @brief Set the single bit at `pos`.
         /// @param pos Bit position to set.
         void set(BitPosition pos) {
@@ -243,28 +292,40 @@ template <size_t Bytes>
             buf.at(pos.getBytePos()) &= static_cast<uint8_t>(~(1 << pos.getBitPos()));
         }
 
-        /// @brief Compute the maximum bit position the operation can reach.
+        /// @brief Compute how many bits an access of `bitCount` bits at `pos` can transfer.
         /// @tparam N Integral type used for value width.
         /// @param pos Starting position.
         /// @param bitCount Number of bits intended to be used.
-        /// @return The last legal bit position (exclusive) given buffer size and value width.
+        /// @return `bitCount` limited by the width of `N` and the end of the buffer.
         template <typename N>
-        BitPosition maxPosition(const BitPosition pos, uint8_t bitCount){
-            BitPosition max = pos;
-            if (bitCount <= sizeof(N) * 8)
+        unsigned fieldWidth(const BitPosition pos, uint8_t bitCount){
+            uint64_t start = pos.getBitIndex();
+            uint64_t end = static_cast<uint64_t>(Bytes) * bitPerByte;
+            uint64_t avail = start < end ? end - start : 0;
+            uint64_t width = bitCount < sizeof(N) * 8 ? bitCount : sizeof(N) * 8;
+            if (bitCount > width || bitCount > avail)
             {
-                if (pos + bitCount < BitPosition(Bytes,0))
-                {
-                    max = pos + bitCount;
-                }else
-                {
-                    max = BitPosition(Bytes,0);
-                }
-            }else{
-                max = BitPosition(Bytes,0);
+                BYTEBUFFER_RECORD_TRUNCATION();
             }
-            return max;
+            return static_cast<unsigned>(width < avail ? width : avail);
         }
+
+        /// @brief Return the number of bits in `range`, 0 if it ends before it starts.
+        /// @throws std::out_of_range if `range` extends beyond the buffer.
+        static uint64_t rangeWidth(const BitRange range) {
+            uint64_t start = range.getStart().getBitIndex();
+            uint64_t last = range.getEnd().getBitIndex();
+            if (last < start)
+            {
+                return 0;
+            }
+            if (last >= static_cast<uint64_t>(Bytes) * bitPerByte)
+            {
+                throw std::out_of_range("ByteBuffer: range exceeds the buffer");
+            }
+            return last - start + 1;
+        }
+
         std::array<uint8_t, Bytes> buf;
     };
 }
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "ByteBuffer.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Selects whether a buffer handed out by an arena or pool is zero-filled.
+enum class Zeroing {
+    zero,   ///< Zero-fill the buffer like the default `ByteBuffer` constructor.
+    keep    ///< Leave the contents unspecified (previous contents when recycled).
+};
+
+/// @brief Slab allocator handing out cache-line-aligned `ByteBuffer<Bytes>` objects.
+/// @details Buffers are carved from slabs of `buffersPerSlab` slots by bumping an offset.
+/// Individual buffers are never freed; `reset()` invalidates every buffer of the current
+/// generation at once and keeps the slabs for reuse, so a steady-state workload does not
+/// allocate. The arena is not thread-safe.
+/// @tparam Bytes Number of bytes stored in each buffer.
+template <size_t Bytes>
+class ByteBufferArena {
+    public:
+        /// @brief Size of a single slot; a multiple of `cacheLineSize`.
+        static constexpr size_t slotSize = (sizeof(ByteBuffer<Bytes>) + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+
+        /// @brief Construct an empty arena; the first slab is allocated on first use.
+        /// @param buffersPerSlab Number of buffers carved from each slab (must be >= 1).
+        explicit ByteBufferArena(size_t buffersPerSlab = 64) : perSlab(buffersPerSlab ? buffersPerSlab : 1) {}
+
+        ByteBufferArena(const ByteBufferArena&) = delete;
+        ByteBufferArena& operator=(const ByteBufferArena&) = delete;
+
+        ~ByteBufferArena() = default;
+
+        /// @brief Hand out a buffer of the current generation.
+        /// @param z Whether the buffer is zero-filled.
+        /// @return Pointer to a cache-line-aligned buffer, valid until the next `reset()`.
+        ByteBuffer<Bytes>* allocate(Zeroing z = Zeroing::zero) {
+            if (slot == perSlab) {
+                slab++;
+                slot = 0;
+            }
+            if (slab == slabs.size()) {
+                slabs.emplace_back(perSlab);
+            }
+            void* mem = slabs[slab].at(slot);
+            slot++;
+            if (z == Zeroing::zero) {
+                return new (mem) ByteBuffer<Bytes>();
+            }
+            return new (mem) ByteBuffer<Bytes>(noInit);
+        }
+
+        /// @brief Invalidate all buffers handed out so far and start a new generation.
+        /// @details The slabs are retained and reused by subsequent allocations.
+        void reset() {
+            slab = 0;
+            slot = 0;
+            gen++;
+        }
+
+        /// @brief Return the current generation; incremented by every `reset()`.
+        uint64_t generation() const { return gen; }
+
+        /// @brief Return the number of slabs allocated so far.
+        size_t slabCount() const { return slabs.size(); }
+
+    private:
+        /// @brief Raw storage for `perSlab` slots aligned to a cache line.
+        class Slab {
+            public:
+                explicit Slab(size_t count) : raw(new unsigned char[count * slotSize + cacheLineSize]) {
+                    void* p = raw.get();
+                    size_t space = count * slotSize + cacheLineSize;
+                    base = static_cast<unsigned char*>(std::align(cacheLineSize, count * slotSize, p, space));
+                }
+                void* at(size_t idx) const { return base + idx * slotSize; }
+            private:
+                std::unique_ptr<unsigned char[]> raw;
+                unsigned char* base;
+        };
+
+        size_t perSlab;
+        size_t slab = 0;
+        size_t slot = 0;
+        uint64_t gen = 0;
+        std::vector<Slab> slabs;
+};
+
+/// @brief Recycling pool of `ByteBuffer<Bytes>` objects backed by a `ByteBufferArena`.
+/// @details Released buffers are kept on a free list and handed out again by `acquire()`,
+/// optionally without re-zeroing; their contents are left untouched while on the list.
+/// A pool is not thread-safe; use `threadLocal()` to get a per-thread pool (and therefore a
+/// per-thread free list). Buffers must be released to the pool that handed them out.
+/// @tparam Bytes Number of bytes stored in each buffer.
+template <size_t Bytes>
+class ByteBufferPool {
+    static_assert(std::is_trivially_destructible<ByteBuffer<Bytes>>::value,
+                  "pooled buffers are recycled without being destroyed");
+    public:
+        /// @brief Construct an empty pool.
+        /// @param buffersPerSlab Number of buffers carved from each arena slab.
+        explicit ByteBufferPool(size_t buffersPerSlab = 64) : arena(buffersPerSlab) {}
+
+        ByteBufferPool(const ByteBufferPool&) = delete;
+        ByteBufferPool& operator=(const ByteBufferPool&) = delete;
+
+        ~ByteBufferPool() = default;
+
+        /// @brief Hand out a buffer, preferring recycled ones.
+        /// @param z Whether the buffer is zero-filled; with `Zeroing::keep` a recycled buffer
+        /// keeps the contents it had when released.
+        /// @return Pointer to a cache-line-aligned buffer owned by the pool.
+        ByteBuffer<Bytes>* acquire(Zeroing z = Zeroing::zero) {
+            if (freeList.empty()) {
+                return arena.allocate(z);
+            }
+            ByteBuffer<Bytes>* b = freeList.back();
+            freeList.pop_back();
+            if (z == Zeroing::zero) {
+                b->fill(0);
+            }
+            return b;
+        }
+
+        /// @brief Return a buffer previously handed out by `acquire()` for recycling.
+        /// @param b Buffer to recycle; `nullptr` is ignored.
+        void release(ByteBuffer<Bytes>* b) {
+            if (b == nullptr) {
+                return;
+            }
+            // the buffer stays alive on the free list: ending its lifetime here would let the
+            // compiler drop the stores made before release (GCC -flifetime-dse) and lose the
+            // contents promised to Zeroing::keep
+            freeList.push_back(b);
+        }
+
+        /// @brief Release every buffer of the current generation at once.
+        /// @details All pointers handed out before are invalid afterwards.
+        void reset() {
+            freeList.clear();
+            arena.reset();
+        }
+
+        /// @brief Return the current arena generation.
+        uint64_t generation() const { return arena.generation(); }
+
+        /// @brief Return the number of buffers waiting on the free list.
+        size_t freeCount() const { return freeList.size(); }
+
+        /// @brief Return the pool owned by the calling thread.
+        static ByteBufferPool& threadLocal() {
+            static thread_local ByteBufferPool pool;
+            return pool;
+        }
+
+    private:
+        ByteBufferArena<Bytes> arena;
+        std::vector<ByteBuffer<Bytes>*> freeList;
+};
+
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "ByteBuffer.hpp"
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief Cache-line-aligned array of `Count` queue slots constructed in place.
+template <typename Slot, size_t Count>
+class QueueSlots {
+    public:
+        QueueSlots() : raw(new unsigned char[Count * sizeof(Slot) + cacheLineSize]) {
+            void* p = raw.get();
+            size_t space = Count * sizeof(Slot) + cacheLineSize;
+            base = static_cast<Slot*>(std::align(cacheLineSize, Count * sizeof(Slot), p, space));
+            for (size_t i = 0; i < Count; i++) {
+                new (base + i) Slot(i);
+            }
+        }
+
+        QueueSlots(const QueueSlots&) = delete;
+        QueueSlots& operator=(const QueueSlots&) = delete;
+
+        ~QueueSlots() {
+            for (size_t i = 0; i < Count; i++) {
+                base[i].~Slot();
+            }
+        }
+
+        Slot& operator[](uint64_t pos) const { return base[pos & (Count - 1)]; }
+
+    private:
+        std::unique_ptr<unsigned char[]> raw;
+        Slot* base;
+};
+
+}
+
+/// @brief Run of consecutive queue slots handed out by `claim()` or `read()`.
+/// @details A batch refers to slots inside its queue; it is only valid until it is passed to
+/// `publish()` or `release()`. An empty batch (`size() == 0`) means nothing was available.
+template <typename Queue>
+class ByteBufferQueueBatch {
+    public:
+        /// @brief Construct an empty batch.
+        ByteBufferQueueBatch() = default;
+
+        /// @brief Return the number of slots in the batch.
+        size_t size() const { return count; }
+
+        /// @brief Return whether the batch holds at least one slot.
+        explicit operator bool() const { return count != 0; }
+
+        /// @brief Return the buffer of slot `i` (0 <= i < size()).
+        typename Queue::Buffer& operator[](size_t i) const { return queue->slot(first + i); }
+
+    private:
+        friend Queue;
+
+        ByteBufferQueueBatch(const Queue* q, uint64_t first, size_t count) : queue(q), first(first), count(count) {}
+
+        const Queue* queue = nullptr;
+        uint64_t first = 0;
+        size_t count = 0;
+};
+
+/// @brief Bounded lock-free single-producer/single-consumer queue of `ByteBuffer<Bytes>` slots.
+/// @details Buffers are filled and read in place: the producer `claim()`s free slots, writes
+/// them and `publish()`es them; the consumer `read()`s published slots and `release()`s them
+/// when done. Nothing is copied. Each slot starts on its own cache line, the producer and
+/// consumer indices live on separate lines, and each side caches the other side's index so
+/// the shared atomics are only touched when the cached view runs out. Batches must be
+/// published and released in the order they were handed out.
+/// @tparam Bytes Size of the buffers.
+/// @tparam Capacity Number of slots; must be a power of two.
+template <size_t Bytes, size_t Capacity>
+class ByteBufferSpscQueue {
+        static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+    public:
+        using Buffer = ByteBuffer<Bytes>;
+        using Batch = ByteBufferQueueBatch<ByteBufferSpscQueue>;
+
+        ByteBufferSpscQueue() = default;
+
+        ByteBufferSpscQueue(const ByteBufferSpscQueue&) = delete;
+        ByteBufferSpscQueue& operator=(const ByteBufferSpscQueue&) = delete;
+
+        /// @brief Return the number of slots.
+        constexpr size_t capacity() const { return Capacity; }
+
+        // producer side
+
+        /// @brief Claim up to `n` free slots for writing.
+        /// @details Claimed slots keep the contents of their previous use.
+        Batch claim(size_t n = 1) {
+            if (Capacity - (claimed - producerTail) < n) {
+                producerTail = tail.load(std::memory_order_acquire);
+            }
+            size_t free = static_cast<size_t>(Capacity - (claimed - producerTail));
+            Batch b(this, claimed, n < free ? n : free);
+            claimed += b.size();
+            return b;
+        }
+
+        /// @brief Make the slots of `b` visible to the consumer.
+        void publish(const Batch& b) {
+            if (b.size() == 0) {
+                return;
+            }
+            head.store(b.first + b.size(), std::memory_order_release);
+        }
+
+        // consumer side
+
+        /// @brief Hand out up to `n` published slots for reading.
+        Batch read(size_t n = 1) {
+            if (consumerHead - reading < n) {
+                consumerHead = head.load(std::memory_order_acquire);
+            }
+            size_t ready = static_cast<size_t>(consumerHead - reading);
+            Batch b(this, reading, n < ready ? n : ready);
+            reading += b.size();
+            return b;
+        }
+
+        /// @brief Return the slots of `b` to the producer.
+        void release(const Batch& b) {
+            if (b.size() == 0) {
+                return;
+            }
+            tail.store(b.first + b.size(), std::memory_order_release);
+        }
+
+    private:
+        friend Batch;
+
+        struct alignas(cacheLineSize) Slot {
+            explicit Slot(size_t) {}
+            Buffer buf;
+        };
+
+        Buffer& slot(uint64_t pos) const { return slots[pos].buf; }
+
+        detail::QueueSlots<Slot, Capacity> slots;
+        // producer-owned line: published position plus the producer's private state
+        alignas(cacheLineSize) std::atomic<uint64_t> head{0};
+        uint64_t claimed = 0;
+        uint64_t producerTail = 0;
+        // consumer-owned line: released position plus the consumer's private state
+        alignas(cacheLineSize) std::atomic<uint64_t> tail{0};
+        uint64_t reading = 0;
+        uint64_t consumerHead = 0;
+};
+
+/// @brief Bounded lock-free multi-producer/multi-consumer queue of `ByteBuffer<Bytes>` slots.
+/// @details Same in-place protocol as `ByteBufferSpscQueue`, but any number of threads may
+/// produce and consume. Every slot carries a sequence number telling whether it is free or
+/// published for a given lap (bounded MPMC queue after D. Vyukov); a claim or read of a batch
+/// costs one CAS on the shared position, and batches may be published and released in any
+/// order. A slot is reused only after its consumer released it.
+/// @tparam Bytes Size of the buffers.
+/// @tparam Capacity Number of slots; must be a power of two.
+template <size_t Bytes, size_t Capacity>
+class ByteBufferMpmcQueue {
+        static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+    public:
+        using Buffer = ByteBuffer<Bytes>;
+        using Batch = ByteBufferQueueBatch<ByteBufferMpmcQueue>;
+
+        ByteBufferMpmcQueue() = default;
+
+        ByteBufferMpmcQueue(const ByteBufferMpmcQueue&) = delete;
+        ByteBufferMpmcQueue& operator=(const ByteBufferMpmcQueue&) = delete;
+
+        /// @brief Return the number of slots.
+        constexpr size_t capacity() const { return Capacity; }
+
+        /// @brief Claim up to `n` consecutive free slots for writing.
+        Batch claim(size_t n = 1) {
+            return take(enqueuePos, n, 0);
+        }
+
+        /// @brief Make the slots of `b` visible to consumers.
+        void publish(const Batch& b) {
+            for (size_t i = 0; i < b.size(); i++) {
+                slots[b.first + i].seq.store(b.first + i + 1, std::memory_order_release);
+            }
+        }
+
+        /// @brief Hand out up to `n` consecutive published slots for reading.
+        Batch read(size_t n = 1) {
+            return take(dequeuePos, n, 1);
+        }
+
+        /// @brief Return the slots of `b` to the producers.
+        void release(const Batch& b) {
+            for (size_t i = 0; i < b.size(); i++) {
+                slots[b.first + i].seq.store(b.first + i + Capacity, std::memory_order_release);
+            }
+        }
+
+    private:
+        friend Batch;
+
+        struct alignas(cacheLineSize) Slot {
+            explicit Slot(size_t pos) : seq(pos) {}
+            std::atomic<uint64_t> seq;
+            Buffer buf;
+        };
+
+        Buffer& slot(uint64_t pos) const { return slots[pos].buf; }
+
+        /// @brief Reserve up to `n` slots at `pos` whose sequence equals their position plus `lag`.
+        Batch take(std::atomic<uint64_t>& pos, size_t n, uint64_t lag) {
+            n = n < Capacity ? n : Capacity;
+            uint64_t first = pos.load(std::memory_order_relaxed);
+            for (;;) {
+                size_t k = 0;
+                while (k < n && slots[first + k].seq.load(std::memory_order_acquire) == first + k + lag) {
+                    k++;
+                }
+                if (k == 0) {
+                    uint64_t seq = slots[first].seq.load(std::memory_order_acquire);
+                    if (static_cast<int64_t>(seq - (first + lag)) < 0) {
+                        return Batch();     // full (claim) or empty (read)
+                    }
+                    first = pos.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (pos.compare_exchange_weak(first, first + k, std::memory_order_relaxed)) {
+                    return Batch(this, first, k);
+                }
+            }
+        }
+
+        detail::QueueSlots<Slot, Capacity> slots;
+        alignas(cacheLineSize) std::atomic<uint64_t> enqueuePos{0};
+        alignas(cacheLineSize) std::atomic<uint64_t> dequeuePos{0};
+};
+
+}
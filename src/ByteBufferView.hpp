@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "ByteBuffer.hpp"
+#include "Endian.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Non-owning mutable view of a contiguous range of bytes.
+/// @details Bulk operations take views so that they work on any `ByteBuffer<Bytes>`,
+/// a part of it, or foreign memory. The viewed memory must outlive the view.
+class ByteBufferView {
+    public:
+        /// @brief Construct a view of `count` bytes starting at `ptr`.
+        constexpr ByteBufferView(uint8_t* ptr, size_t count) : ptr(ptr), count(count) {}
+
+        /// @brief Construct a view of the whole buffer `b`.
+        template <size_t Bytes>
+        ByteBufferView(ByteBuffer<Bytes>& b) : ByteBufferView(b.data(), b.size()) {}
+
+        /// @brief Return a pointer to the first viewed byte.
+        constexpr uint8_t* data() const { return ptr; }
+
+        /// @brief Return the number of viewed bytes.
+        constexpr size_t size() const { return count; }
+
+        /// @brief Return a view of `n` bytes starting at byte `offset` (clamped to this view).
+        ByteBufferView subView(size_t offset, size_t n) const {
+            if (offset > count) {
+                offset = count;
+            }
+            if (n > count - offset) {
+                n = count - offset;
+            }
+            return ByteBufferView(ptr + offset, n);
+        }
+
+    private:
+        uint8_t* ptr;
+        size_t count;
+};
+
+/// @brief Non-owning read-only view of a contiguous range of bytes.
+class ConstByteBufferView {
+    public:
+        /// @brief Construct a view of `count` bytes starting at `ptr`.
+        constexpr ConstByteBufferView(const uint8_t* ptr, size_t count) : ptr(ptr), count(count) {}
+
+        /// @brief Construct a read-only view from a mutable one.
+        constexpr ConstByteBufferView(ByteBufferView v) : ptr(v.data()), count(v.size()) {}
+
+        /// @brief Construct a view of the whole buffer `b`.
+        template <size_t Bytes>
+        ConstByteBufferView(const ByteBuffer<Bytes>& b) : ConstByteBufferView(b.getData(), b.size()) {}
+
+        /// @brief Return a pointer to the first viewed byte.
+        constexpr const uint8_t* data() const { return ptr; }
+
+        /// @brief Return the number of viewed bytes.
+        constexpr size_t size() const { return count; }
+
+        /// @brief Return a view of `n` bytes starting at byte `offset` (clamped to this view).
+        ConstByteBufferView subView(size_t offset, size_t n) const {
+            if (offset > count) {
+                offset = count;
+            }
+            if (n > count - offset) {
+                n = count - offset;
+            }
+            return ConstByteBufferView(ptr + offset, n);
+        }
+
+    private:
+        const uint8_t* ptr;
+        size_t count;
+};
+
+/// @brief Return the range covering all bits of `v`.
+/// @note An empty view yields the single-bit range at position 0; range-based operations clamp it away.
+inline BitRange wholeRange(ConstByteBufferView v) {
+    return v.size() == 0 ? BitRange(bitPositionZero, bitPositionZero)
+                         : BitRange(bitPositionZero, BitPosition(static_cast<uint32_t>(v.size() - 1), bitPerByte - 1));
+}
+
+namespace detail {
+
+/// @brief Bits of a `BitRange` inside a view, seen as whole bytes plus a trailing partial byte.
+/// @details Byte `i` holds the 8 bits starting at `start + 8 * i` with the first bit in its LSB, i.e.
+/// the value `get<uint8_t>(start + 8 * i, 8)` would return. The range is clamped to the view.
+class RangeBytes {
+    public:
+        RangeBytes(ConstByteBufferView v, BitRange range) : ptr(v.data()), shift(range.getStart().getBitPos()) {
+            uint64_t startBit = range.getStart().getBitIndex();
+            uint64_t endBit = range.getEnd().getBitIndex() + 1;
+            uint64_t maxBit = static_cast<uint64_t>(v.size()) * bitPerByte;
+            if (endBit > maxBit) {
+                endBit = maxBit;
+            }
+            uint64_t bits = 0;
+            if (startBit < maxBit) {
+                ptr += range.getStart().getBytePos();
+                bits = endBit > startBit ? endBit - startBit : 0;
+            }
+            full = static_cast<size_t>(bits / bitPerByte);
+            rest = static_cast<uint8_t>(bits % bitPerByte);
+        }
+
+        /// @brief Number of whole bytes.
+        size_t fullBytes() const { return full; }
+
+        /// @brief Number of bits in the trailing partial byte (0..7).
+        uint8_t restBits() const { return rest; }
+
+        /// @brief Whether the range starts on a byte boundary.
+        bool aligned() const { return shift == 0; }
+
+        /// @brief Pointer to the first byte containing range bits.
+        const uint8_t* data() const { return ptr; }
+
+        /// @brief Return whole byte `i`.
+        uint8_t byte(size_t i) const {
+            if (shift == 0) {
+                return ptr[i];
+            }
+            return static_cast<uint8_t>((ptr[i] >> shift) | (ptr[i + 1] << (bitPerByte - shift)));
+        }
+
+        /// @brief Return the trailing partial byte in the low `restBits()` bits.
+        uint8_t restByte() const {
+            if (rest == 0) {
+                return 0;
+            }
+            uint32_t v = static_cast<uint32_t>(ptr[full] >> shift);
+            if (shift + rest > bitPerByte) {
+                v |= static_cast<uint32_t>(ptr[full + 1]) << (bitPerByte - shift);
+            }
+            return static_cast<uint8_t>(v & ((1u << rest) - 1));
+        }
+
+        /// @brief Return 8 whole bytes starting at whole byte `i` as a little-endian word.
+        /// @note Requires `i + 8 <= fullBytes()`.
+        uint64_t word(size_t i) const {
+            uint64_t w = detail::loadLe64(ptr + i);
+            if (shift == 0) {
+                return w;
+            }
+            return (w >> shift) | (static_cast<uint64_t>(ptr[i + 8]) << (64 - shift));
+        }
+
+    private:
+        const uint8_t* ptr;
+        uint8_t shift;
+        size_t full;
+        uint8_t rest;
+};
+
+}
+
+}
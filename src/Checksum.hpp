@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+#include "BitRange.hpp"
+#include "ByteBufferView.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Parameters of a CRC in the usual Rocksoft/Williams notation.
+/// @tparam T Unsigned type holding the CRC register; must be at least `width` bits wide.
+template <typename T>
+struct CrcParams {
+    uint8_t width;      ///< Number of CRC bits (8..64).
+    T poly;             ///< Generator polynomial, normal (MSB-first) form without the top bit.
+    T init;             ///< Initial register value.
+    bool reflectIn;     ///< Process input bytes LSB first.
+    bool reflectOut;    ///< Reflect the register before the final xor.
+    T xorOut;           ///< Value xored into the final register.
+};
+
+/// @brief CRC-8/SMBUS.
+constexpr CrcParams<uint8_t> crc8Smbus{8, 0x07, 0x00, false, false, 0x00};
+/// @brief CRC-16/CCITT-FALSE.
+constexpr CrcParams<uint16_t> crc16CcittFalse{16, 0x1021, 0xffff, false, false, 0x0000};
+/// @brief CRC-16/ARC.
+constexpr CrcParams<uint16_t> crc16Arc{16, 0x8005, 0x0000, true, true, 0x0000};
+/// @brief CRC-32 (IEEE 802.3).
+constexpr CrcParams<uint32_t> crc32Ieee{32, 0x04c11db7, 0xffffffff, true, true, 0xffffffff};
+/// @brief CRC-32C (Castagnoli).
+constexpr CrcParams<uint32_t> crc32Castagnoli{32, 0x1edc6f41, 0xffffffff, true, true, 0xffffffff};
+/// @brief CRC-64/ECMA-182.
+constexpr CrcParams<uint64_t> crc64Ecma{64, 0x42f0e1eba9ea3693, 0x0, false, false, 0x0};
+/// @brief CRC-64/XZ.
+constexpr CrcParams<uint64_t> crc64Xz{64, 0x42f0e1eba9ea3693, 0xffffffffffffffff, true, true, 0xffffffffffffffff};
+
+namespace detail {
+
+template <typename T>
+T reflect(T v, uint8_t width) {
+    T r = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        if ((v >> i) & 1) {
+            r = static_cast<T>(r | (static_cast<T>(1) << (width - 1 - i)));
+        }
+    }
+    return r;
+}
+
+}
+
+/// @brief Table-driven CRC with configurable width and polynomial.
+/// @details The CRC is computed over the bits of a `BitRange` in place. The range is processed as
+/// whole bytes (as returned by `get<uint8_t>(pos, 8)` at successive byte offsets from the range
+/// start) followed by the trailing partial bits. The partial bits are fed in the bit order of the
+/// CRC: LSB first for reflected CRCs, from the highest partial bit down for the others. For a
+/// byte-aligned range of whole bytes the result equals the standard CRC of those bytes.
+/// @tparam T Unsigned type holding the CRC register.
+template <typename T>
+class Crc {
+    public:
+        /// @brief Build the 256-entry lookup table for `params`.
+        explicit Crc(const CrcParams<T>& params) : p(params) {
+            mask = p.width >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << p.width) - 1;
+            rpoly = detail::reflect<uint64_t>(p.poly, p.width);
+            for (uint32_t i = 0; i < 256; i++) {
+                uint64_t r;
+                if (p.reflectIn) {
+                    r = i;
+                    for (int b = 0; b < 8; b++) {
+                        r = (r & 1) ? (r >> 1) ^ rpoly : r >> 1;
+                    }
+                } else {
+                    r = static_cast<uint64_t>(i) << (p.width - 8);
+                    for (int b = 0; b < 8; b++) {
+                        r = (r >> (p.width - 1)) & 1 ? ((r << 1) ^ p.poly) & mask : (r << 1) & mask;
+                    }
+                }
+                table[i] = static_cast<T>(r);
+            }
+        }
+
+        /// @brief Return the register value before any input.
+        T begin() const {
+            return static_cast<T>(p.reflectIn ? detail::reflect<uint64_t>(p.init, p.width) : p.init);
+        }
+
+        /// @brief Feed the bits of `range` in `v` into the register `state`.
+        T update(T state, ConstByteBufferView v, BitRange range) const {
+            detail::RangeBytes rb(v, range);
+            uint64_t crc = state;
+            size_t n = rb.fullBytes();
+            if (p.reflectIn) {
+                for (size_t i = 0; i < n; i++) {
+                    crc = table[(crc ^ rb.byte(i)) & 0xff] ^ (crc >> 8);
+                }
+                uint8_t rest = rb.restByte();
+                for (uint8_t b = 0; b < rb.restBits(); b++) {
+                    crc ^= (rest >> b) & 1;
+                    crc = (crc & 1) ? (crc >> 1) ^ rpoly : crc >> 1;
+                }
+            } else {
+                for (size_t i = 0; i < n; i++) {
+                    crc = (table[((crc >> (p.width - 8)) ^ rb.byte(i)) & 0xff] ^ (crc << 8)) & mask;
+                }
+                uint8_t rest = rb.restByte();
+                for (uint8_t b = rb.restBits(); b > 0; b--) {
+                    uint64_t top = ((crc >> (p.width - 1)) ^ (rest >> (b - 1))) & 1;
+                    crc = (crc << 1) & mask;
+                    if (top) {
+                        crc ^= p.poly;
+                    }
+                }
+            }
+            return static_cast<T>(crc);
+        }
+
+        /// @brief Apply output reflection and the final xor to the register `state`.
+        T finish(T state) const {
+            uint64_t crc = state;
+            if (p.reflectIn != p.reflectOut) {
+                crc = detail::reflect<uint64_t>(crc, p.width);
+            }
+            return static_cast<T>((crc ^ p.xorOut) & mask);
+        }
+
+        /// @brief Compute the CRC over the bits of `range` in `v`.
+        T compute(ConstByteBufferView v, BitRange range) const {
+            return finish(update(begin(), v, range));
+        }
+
+        /// @brief Compute the CRC over all bytes of `v`.
+        T compute(ConstByteBufferView v) const {
+            return compute(v, wholeRange(v));
+        }
+
+    private:
+        CrcParams<T> p;
+        uint64_t mask;
+        uint64_t rpoly;
+        std::array<T, 256> table;
+};
+
+/// @brief Compute the CRC-32C (Castagnoli) over the bits of `range` in `v`.
+/// @details Uses the SSE4.2 `crc32` instruction on 8 bytes at a time when compiled with SSE4.2
+/// support, also for ranges that do not start on a byte boundary; trailing partial bits are
+/// handled as described for `Crc`.
+inline uint32_t crc32c(ConstByteBufferView v, BitRange range) {
+    static const Crc<uint32_t> crc(crc32Castagnoli);
+#if defined(__SSE4_2__)
+    detail::RangeBytes rb(v, range);
+    uint64_t state = crc.begin();
+    size_t n = rb.fullBytes();
+    size_t i = 0;
+    // an unaligned word needs one byte beyond its 8 whole bytes
+    size_t words = rb.aligned() ? n / 8 : (n == 0 ? 0 : (n - 1) / 8);
+    for (; i < words * 8; i += 8) {
+        state = _mm_crc32_u64(state, rb.word(i));
+    }
+    uint32_t s = static_cast<uint32_t>(state);
+    for (; i < n; i++) {
+        s = _mm_crc32_u8(s, rb.byte(i));
+    }
+    uint64_t startBit = range.getStart().getBitIndex() + n * bitPerByte;
+    if (rb.restBits() != 0) {
+        BitPosition restStart(static_cast<uint32_t>(startBit / bitPerByte), static_cast<uint8_t>(startBit % bitPerByte));
+        s = crc.update(s, v, BitRange(restStart, range.getEnd()));
+    }
+    return crc.finish(s);
+#else
+    return crc.compute(v, range);
+#endif
+}
+
+/// @brief Compute the CRC-32C (Castagnoli) over all bytes of `v`.
+inline uint32_t crc32c(ConstByteBufferView v) {
+    return crc32c(v, wholeRange(v));
+}
+
+/// @brief Compute the Internet checksum (RFC 1071) over the bits of `range` in `v`.
+/// @details The range is read as whole bytes like `Crc`; a trailing partial byte is used as
+/// the low bits of a final byte padded with zeros, and an odd byte count is padded with a zero byte.
+/// @return The one's complement of the one's complement sum, in host byte order.
+inline uint16_t internetChecksum(ConstByteBufferView v, BitRange range) {
+    detail::RangeBytes rb(v, range);
+    size_t n = rb.fullBytes();
+    uint64_t sum = 0;
+    size_t i = 0;
+    if (rb.aligned()) {
+        const uint8_t* p = rb.data();
+        for (; i + 1 < n; i += 2) {
+            sum += static_cast<uint32_t>(p[i] << 8 | p[i + 1]);
+        }
+    } else {
+        for (; i + 1 < n; i += 2) {
+            sum += static_cast<uint32_t>(rb.byte(i) << 8 | rb.byte(i + 1));
+        }
+    }
+    uint32_t last[2] = {0, 0};
+    size_t lastCnt = 0;
+    if (i < n) {
+        last[lastCnt++] = rb.byte(i);
+    }
+    if (rb.restBits() != 0) {
+        last[lastCnt++] = rb.restByte();
+    }
+    if (lastCnt != 0) {
+        sum += last[0] << 8 | last[1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return static_cast<uint16_t>(~sum);
+}
+
+/// @brief Compute the Internet checksum (RFC 1071) over all bytes of `v`.
+inline uint16_t internetChecksum(ConstByteBufferView v) {
+    return internetChecksum(v, wholeRange(v));
+}
+
+}
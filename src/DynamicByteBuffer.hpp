@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "ByteBuffer.hpp"
+#include "ByteBufferView.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Number of bytes a `DynamicByteBuffer` stores without a heap allocation.
+constexpr size_t dynamicInlineCapacity = 32;
+
+/// @brief Growable heap-backed byte buffer with bit-level access.
+/// @details Offers the `get`/`set`/`at` API of `ByteBuffer<Bytes>` with a size chosen at run time.
+/// Up to `dynamicInlineCapacity` bytes are stored inside the object (small-buffer optimization); larger
+/// buffers live on the heap and grow geometrically. `append` writes fields after the last
+/// appended bit and grows the buffer as needed. Moves are cheap and `noexcept`; copies must be
+/// requested explicitly (copy construction or `clone()`).
+class DynamicByteBuffer {
+    public:
+        /// @brief Construct an empty buffer.
+        DynamicByteBuffer() = default;
+
+        /// @brief Construct a zero-initialized buffer of `bytes` bytes.
+        explicit DynamicByteBuffer(size_t bytes) { resize(bytes); }
+
+        /// @brief Construct a deep copy of `other`.
+        explicit DynamicByteBuffer(const DynamicByteBuffer& other) {
+            reserve(other.size());
+            std::memcpy(ptr, other.ptr, other.size());
+            bits = other.bits;
+        }
+
+        /// @brief Take over the contents of `other`, leaving it empty.
+        DynamicByteBuffer(DynamicByteBuffer&& other) noexcept {
+            moveFrom(other);
+        }
+
+        DynamicByteBuffer& operator=(const DynamicByteBuffer&) = delete;
+
+        /// @brief Take over the contents of `other`, leaving it empty.
+        DynamicByteBuffer& operator=(DynamicByteBuffer&& other) noexcept {
+            if (this != &other) {
+                release();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        ~DynamicByteBuffer() { release(); }
+
+        /// @brief Return a deep copy of this buffer.
+        DynamicByteBuffer clone() const { return DynamicByteBuffer(*this); }
+
+        /// @brief Return the number of bytes in the buffer.
+        size_t size() const { return static_cast<size_t>((bits + bitPerByte - 1) / bitPerByte); }
+
+        /// @brief Return the number of bits in the buffer (the position the next `append` writes to).
+        uint64_t bitSize() const { return bits; }
+
+        /// @brief Return the number of bytes the buffer can hold without reallocating.
+        size_t capacity() const { return cap; }
+
+        /// @brief Ensure the buffer can hold `bytes` bytes without reallocating.
+        void reserve(size_t bytes) {
+            if (bytes <= cap) {
+                return;
+            }
+            uint8_t* mem = new uint8_t[bytes];
+            std::memcpy(mem, ptr, size());
+            release();
+            ptr = mem;
+            cap = bytes;
+        }
+
+        /// @brief Change the size to `bytes` bytes; new bytes are zero.
+        void resize(size_t bytes) {
+            size_t old = size();
+            if (bytes > cap) {
+                reserve(grownCapacity(bytes));
+            }
+            if (bytes > old) {
+                std::memset(ptr + old, 0, bytes - old);
+            }
+            bits = static_cast<uint64_t>(bytes) * bitPerByte;
+        }
+
+        /// @brief Remove all bytes; the capacity is kept.
+        void clear() { bits = 0; }
+
+        /// @brief Append the low `bitCount` bits of `value` after the last bit, growing the buffer as needed.
+        /// @details `bitCount` is limited to the width of `N`. Bits of the last byte beyond the new
+        /// end are zero.
+        template <typename N>
+        void append(N value, uint8_t bitCount) {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            if (bitCount > sizeof(N) * bitPerByte) {
+                bitCount = sizeof(N) * bitPerByte;
+            }
+            BitPosition pos(static_cast<uint32_t>(bits / bitPerByte), static_cast<uint8_t>(bits % bitPerByte));
+            size_t old = size();
+            size_t need = static_cast<size_t>((bits + bitCount + bitPerByte - 1) / bitPerByte);
+            if (need > cap) {
+                reserve(grownCapacity(need));
+            }
+            if (need > old) {
+                std::memset(ptr + old, 0, need - old);
+            }
+            bits += bitCount;
+            set(pos, value, bitCount);
+        }
+
+        /// @brief Insert up to `bitCount` bits of `value` starting at bit position `pos`.
+        /// @details Same semantics as `ByteBuffer::set`; bits beyond the end of the buffer are truncated.
+        template <typename N>
+        void set(const BitPosition pos, N value, const uint8_t bitCount) {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            unsigned width = fieldWidth<N>(pos, bitCount);
+            if (width != 0) {
+                detail::writeField(ptr, size(), pos.getBitIndex(), static_cast<uint64_t>(value), width);
+            }
+            BYTEBUFFER_RECORD_SET(sizeof(N), pos, width);
+        }
+
+        /// @brief Insert bits of `value` into the buffer over the specified `range`.
+        /// @details Same semantics as `ByteBuffer::set`.
+        /// @throws std::out_of_range if `range` extends beyond the buffer.
+        template <typename N>
+        void set(const BitRange range, N value) {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            uint64_t start = range.getStart().getBitIndex();
+            uint64_t width = rangeWidth(range);
+            uint64_t raw = static_cast<uint64_t>(value);
+            uint64_t fill = std::is_signed<N>::value && (raw >> 63) != 0 ? ~static_cast<uint64_t>(0) : 0;
+            for (uint64_t done = 0; done < width; done += 64) {
+                unsigned chunk = static_cast<unsigned>(width - done < 64 ? width - done : 64);
+                detail::writeField(ptr, size(), start + done, done == 0 ? raw : fill, chunk);
+            }
+            BYTEBUFFER_RECORD_SET(sizeof(N), range.getStart(), static_cast<uint32_t>(width));
+        }
+
+        /// @brief Set or clear a single bit at `pos` according to the least-significant bit of `value`.
+        template <typename N>
+        void set(const BitPosition pos, const N value) {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            BYTEBUFFER_RECORD_SET(sizeof(N), pos, 1);
+            setBit(pos, value);
+        }
+
+        /// @brief Retrieve up to `bitCount` bits starting at `pos`, packed into the return value from LSB upwards.
+        template <typename N>
+        N get(const BitPosition pos, const uint8_t bitCount) const {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            unsigned width = fieldWidth<N>(pos, bitCount);
+            BYTEBUFFER_RECORD_GET(sizeof(N), pos, width);
+            if (width == 0) {
+                return 0;
+            }
+            return static_cast<N>(detail::readField(ptr, size(), pos.getBitIndex(), width));
+        }
+
+        /// @brief Retrieve bits from `range` and return them packed in the lower bits of the result.
+        /// @throws std::out_of_range if `range` extends beyond the buffer.
+        template <typename N>
+        N get(const BitRange range) const {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            uint64_t width = rangeWidth(range);
+            BYTEBUFFER_RECORD_GET(sizeof(N), range.getStart(), static_cast<uint32_t>(width));
+            if (width == 0) {
+                return 0;
+            }
+            unsigned used = static_cast<unsigned>(width < 64 ? width : 64);
+            return static_cast<N>(detail::readField(ptr, size(), range.getStart().getBitIndex(), used));
+        }
+
+        /// @brief Retrieve a single bit at `pos` and return it in the least-significant bit of the result.
+        template <typename N>
+        N get(BitPosition pos) const {
+            BYTEBUFFER_RECORD_GET(sizeof(N), pos, 1);
+            return getBit<N>(pos);
+        }
+
+        /// @brief Return a `Bits` proxy bound to `range`.
+        Bits at(const BitRange range) {
+            auto setter = [range,this](uint32_t value) { set<uint32_t>(range,value);};
+            std::function<uint32_t(void)> getter = [range,this]() {return get<uint32_t>(range);};
+            Bits ret( setter , getter );
+            BYTEBUFFER_RECORD_PROXY();
+            return ret;
+        }
+
+        /// @brief Return a `Bits` proxy that represents `b` bytes starting at bit position `pos`.
+        Bits at(const BitPosition pos, const Byte b) {
+            return at(BitRange(pos,b.bits));
+        }
+
+        /// @brief Return a `Bit` proxy bound to the single bit at `pos`.
+        Bit at(const BitPosition pos) {
+            auto setter = [pos,this](uint32_t value) { set<uint32_t>(pos,value);};
+            std::function<uint32_t(void)> getter = [pos,this]() {return get<uint32_t>(pos);};
+            Bit ret( setter , getter );
+            BYTEBUFFER_RECORD_PROXY();
+            return ret;
+        }
+
+        /// @brief Fill every byte of the buffer with `val`.
+        void fill(uint8_t val) { std::memset(ptr, val, size()); }
+
+        /// @brief Return a pointer to the data.
+        /// @note The caller should verify the number of bytes with `size()`.
+        const uint8_t* getData() const { return ptr; }
+
+        /// @brief Return a mutable pointer to the data; invalidated by growth.
+        uint8_t* data() { return ptr; }
+
+        /// @brief View the whole buffer; invalidated by growth.
+        operator ByteBufferView() { return ByteBufferView(ptr, size()); }
+
+        /// @brief View the whole buffer read-only; invalidated by growth.
+        operator ConstByteBufferView() const { return ConstByteBufferView(ptr, size()); }
+
+    private:
+        bool isInline() const { return ptr == inlineBuf; }
+
+        void release() {
+            if (!isInline()) {
+                delete[] ptr;
+                ptr = inlineBuf;
+                cap = dynamicInlineCapacity;
+            }
+        }
+
+        void moveFrom(DynamicByteBuffer& other) noexcept {
+            if (other.isInline()) {
+                std::memcpy(inlineBuf, other.inlineBuf, dynamicInlineCapacity);
+                ptr = inlineBuf;
+                cap = dynamicInlineCapacity;
+            } else {
+                ptr = other.ptr;
+                cap = other.cap;
+                other.ptr = other.inlineBuf;
+                other.cap = dynamicInlineCapacity;
+            }
+            bits = other.bits;
+            other.bits = 0;
+        }
+
+        size_t grownCapacity(size_t need) const {
+            size_t c = cap * 2;
+            return c < need ? need : c;
+        }
+
+        template <typename N>
+        N getBit(BitPosition pos) const {
+            if (pos.getBytePos() >= size()) {
+                throw std::out_of_range("DynamicByteBuffer: position out of range");
+            }
+            N cont = ptr[pos.getBytePos()];
+            N cont_without = (cont >> pos.getBitPos());
+            return cont_without & 1;
+        }
+
+        template <typename N>
+        void setBit(BitPosition pos, const N value) {
+            if (pos.getBytePos() >= size()) {
+                throw std::out_of_range("DynamicByteBuffer: position out of range");
+            }
+            if ((value & 1) == 1)
+            {
+                ptr[pos.getBytePos()] |= static_cast<uint8_t>(1 << pos.getBitPos());
+            }else
+            {
+                ptr[pos.getBytePos()] &= static_cast<uint8_t>(~(1 << pos.getBitPos()));
+            }
+        }
+
+        /// @brief Compute the bits an access can transfer like `ByteBuffer::fieldWidth`.
+        template <typename N>
+        unsigned fieldWidth(const BitPosition pos, uint8_t bitCount) const {
+            uint64_t start = pos.getBitIndex();
+            uint64_t end = static_cast<uint64_t>(size()) * bitPerByte;
+            uint64_t avail = start < end ? end - start : 0;
+            uint64_t width = bitCount < sizeof(N) * 8 ? bitCount : sizeof(N) * 8;
+            if (bitCount > width || bitCount > avail) {
+                BYTEBUFFER_RECORD_TRUNCATION();
+            }
+            return static_cast<unsigned>(width < avail ? width : avail);
+        }
+
+        /// @brief Return the number of bits in `range`, 0 if it ends before it starts.
+        uint64_t rangeWidth(const BitRange range) const {
+            uint64_t start = range.getStart().getBitIndex();
+            uint64_t last = range.getEnd().getBitIndex();
+            if (last < start) {
+                return 0;
+            }
+            if (last >= static_cast<uint64_t>(size()) * bitPerByte) {
+                throw std::out_of_range("DynamicByteBuffer: position out of range");
+            }
+            return last - start + 1;
+        }
+
+        uint8_t* ptr = inlineBuf;
+        size_t cap = dynamicInlineCapacity;
+        uint64_t bits = 0;
+        uint8_t inlineBuf[dynamicInlineCapacity] = {};
+};
+
+}
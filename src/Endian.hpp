@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/// @file
+/// @brief Little-endian loads and stores of whole words.
+/// @details Buffers number their bits LSB first from byte 0, so a word loaded from a buffer must
+/// have byte 0 in its lowest bits whatever the byte order of the host. On little-endian hosts these
+/// are plain unaligned copies; on big-endian hosts the bytes are swapped.
+
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__ && __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__)
+#error "ByteBuffer: unknown host byte order"
+#endif
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief Whether the host stores words little-endian, i.e. native word copies keep the buffer's bit order.
+constexpr bool hostLittleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+inline uint64_t loadLe64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+inline void storeLe64(uint8_t* p, uint64_t v) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline uint32_t loadLe32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+inline void storeLe32(uint8_t* p, uint32_t v) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline uint16_t loadLe16(const uint8_t* p) {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap16(v);
+#endif
+    return v;
+}
+
+inline void storeLe16(uint8_t* p, uint16_t v) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap16(v);
+#endif
+    std::memcpy(p, &v, sizeof(v));
+}
+
+/// @brief Load the `n` (0..8) bytes at `p` as the low bytes of a little-endian word; the rest is zero.
+inline uint64_t loadLePartial(const uint8_t* p, size_t n) {
+    uint8_t tmp[8] = {};
+    std::memcpy(tmp, p, n);
+    return loadLe64(tmp);
+}
+
+/// @brief Store the low `n` (0..8) bytes of the little-endian word `v` at `p`.
+inline void storeLePartial(uint8_t* p, uint64_t v, size_t n) {
+    uint8_t tmp[8];
+    storeLe64(tmp, v);
+    std::memcpy(p, tmp, n);
+}
+
+}
+
+}
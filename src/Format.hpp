@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#include "BitPosition.h"
+#include "BitRange.hpp"
+#include "ByteBufferView.hpp"
+
+/// @file
+/// @brief Allocation-free formatting of buffers, bit ranges and field values.
+/// @details Every function writes into a caller-supplied character array `out` of `cap`
+/// characters and returns the number of characters written. If `cap` is too small nothing is
+/// written and 0 is returned. No terminating NUL is written.
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief Lookup tables for hex and binary rendering, built at compile time.
+struct FormatTables {
+    char hex[256][2];       ///< Two lower-case hex digits per byte value.
+    char bits[256][8];      ///< Eight '0'/'1' characters per byte value, bit 0 first.
+    char digits[100][2];    ///< Two decimal digits per value 0..99.
+
+    constexpr FormatTables() : hex(), bits(), digits() {
+        for (int i = 0; i < 256; i++) {
+            hex[i][0] = "0123456789abcdef"[i >> 4];
+            hex[i][1] = "0123456789abcdef"[i & 0xf];
+            for (int b = 0; b < 8; b++) {
+                bits[i][b] = ((i >> b) & 1) ? '1' : '0';
+            }
+        }
+        for (int i = 0; i < 100; i++) {
+            digits[i][0] = static_cast<char>('0' + i / 10);
+            digits[i][1] = static_cast<char>('0' + i % 10);
+        }
+    }
+};
+
+inline const FormatTables& formatTables() {
+    static constexpr FormatTables tables{};
+    return tables;
+}
+
+/// @brief Write the hex digits of `n` bytes from `p` to `out` (2 * n characters).
+inline void hexBytes(char* out, const uint8_t* p, size_t n) {
+    const FormatTables& t = formatTables();
+    size_t i = 0;
+#if defined(__SSSE3__)
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i low = _mm_set1_epi8(0x0f);
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), low));
+        __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+    for (; i < n; i++) {
+        std::memcpy(out + 2 * i, t.hex[p[i]], 2);
+    }
+}
+
+/// @brief Number of decimal digits of `v`.
+inline size_t decimalDigits(uint64_t v) {
+    size_t n = 1;
+    while (v >= 100) {
+        v /= 100;
+        n += 2;
+    }
+    return v >= 10 ? n + 1 : n;
+}
+
+/// @brief Write the `len` decimal digits of `v` ending at `out + len`.
+inline void decimal(char* out, size_t len, uint64_t v) {
+    const FormatTables& t = formatTables();
+    char* end = out + len;
+    while (v >= 100) {
+        end -= 2;
+        std::memcpy(end, t.digits[v % 100], 2);
+        v /= 100;
+    }
+    if (v >= 10) {
+        end -= 2;
+        std::memcpy(end, t.digits[v], 2);
+    } else {
+        *--end = static_cast<char>('0' + v);
+    }
+}
+
+}
+
+/// @brief Number of characters `formatHexDump` writes for `bytes` bytes.
+constexpr size_t hexDumpSize(size_t bytes) {
+    return bytes / 16 * 58 + (bytes % 16 == 0 ? 0 : 10 + (bytes % 16) * 3);
+}
+
+/// @brief Write `v` in decimal.
+inline size_t formatDecimal(char* out, size_t cap, uint64_t v) {
+    size_t len = detail::decimalDigits(v);
+    if (len > cap) {
+        return 0;
+    }
+    detail::decimal(out, len, v);
+    return len;
+}
+
+/// @brief Write `v` in lower-case hex with at least `minDigits` digits (no prefix).
+inline size_t formatHexValue(char* out, size_t cap, uint64_t v, size_t minDigits = 1) {
+    size_t len = 1;
+    while (len < 16 && (v >> (4 * len)) != 0) {
+        len++;
+    }
+    if (len < minDigits) {
+        len = minDigits > 16 ? 16 : minDigits;
+    }
+    if (len > cap) {
+        return 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        out[len - 1 - i] = "0123456789abcdef"[(v >> (4 * i)) & 0xf];
+    }
+    return len;
+}
+
+/// @brief Write `pos` as "byte.bit", like `operator<<` for `BitPosition`.
+inline size_t formatPosition(char* out, size_t cap, BitPosition pos) {
+    size_t len = detail::decimalDigits(pos.getBytePos());
+    if (len + 2 > cap) {
+        return 0;
+    }
+    detail::decimal(out, len, pos.getBytePos());
+    out[len] = '.';
+    out[len + 1] = static_cast<char>('0' + pos.getBitPos());
+    return len + 2;
+}
+
+/// @brief Write all bytes of `v` as contiguous lower-case hex digits (two per byte).
+inline size_t formatHex(char* out, size_t cap, ConstByteBufferView v) {
+    if (2 * v.size() > cap) {
+        return 0;
+    }
+    detail::hexBytes(out, v.data(), v.size());
+    return 2 * v.size();
+}
+
+/// @brief Write a hex dump of `v`: one line per 16 bytes, "oooooooo  xx xx ... xx\n".
+/// @details The offset is 8 hex digits. The required size is `hexDumpSize(v.size())`.
+inline size_t formatHexDump(char* out, size_t cap, ConstByteBufferView v) {
+    size_t total = hexDumpSize(v.size());
+    if (total > cap) {
+        return 0;
+    }
+    const uint8_t* p = v.data();
+    char pairs[32];
+    char* o = out;
+    for (size_t line = 0; line < v.size(); line += 16) {
+        size_t n = v.size() - line < 16 ? v.size() - line : 16;
+        formatHexValue(o, 8, line, 8);
+        o[8] = ' ';
+        o[9] = ' ';
+        o += 10;
+        detail::hexBytes(pairs, p + line, n);
+        for (size_t i = 0; i < n; i++) {
+            o[0] = pairs[2 * i];
+            o[1] = pairs[2 * i + 1];
+            o[2] = ' ';
+            o += 3;
+        }
+        o[-1] = '\n';
+    }
+    return total;
+}
+
+/// @brief Write the bits of `range` in `v` as '0'/'1' characters in position order (first bit first).
+/// @details The range is clamped to the view; a range outside the view writes nothing.
+inline size_t formatBits(char* out, size_t cap, ConstByteBufferView v, BitRange range) {
+    detail::RangeBytes rb(v, range);
+    size_t len = rb.fullBytes() * bitPerByte + rb.restBits();
+    if (len > cap) {
+        return 0;
+    }
+    const detail::FormatTables& t = detail::formatTables();
+    for (size_t i = 0; i < rb.fullBytes(); i++) {
+        std::memcpy(out + i * bitPerByte, t.bits[rb.byte(i)], bitPerByte);
+    }
+    std::memcpy(out + rb.fullBytes() * bitPerByte, t.bits[rb.restByte()], rb.restBits());
+    return len;
+}
+
+/// @brief Write the value of the field `range` in `v` in decimal.
+/// @details The value is what `get<uint64_t>(range)` returns; ranges wider than 64 bits use their
+/// first 64 bits.
+inline size_t formatField(char* out, size_t cap, ConstByteBufferView v, BitRange range) {
+    detail::RangeBytes rb(v, range);
+    uint64_t value = 0;
+    size_t n = rb.fullBytes() < 8 ? rb.fullBytes() : 8;
+    for (size_t i = 0; i < n; i++) {
+        value |= static_cast<uint64_t>(rb.byte(i)) << (i * bitPerByte);
+    }
+    if (n < 8) {
+        value |= static_cast<uint64_t>(rb.restByte()) << (n * bitPerByte);
+    }
+    return formatDecimal(out, cap, value);
+}
+
+/// @brief Write `range` annotated with its positions: "start .. end: bits".
+/// @details The positions use the "byte.bit" notation of `formatPosition`, matching
+/// `operator<<` for `BitRange`.
+inline size_t formatRange(char* out, size_t cap, ConstByteBufferView v, BitRange range) {
+    char tmp[32];
+    size_t a = formatPosition(tmp, sizeof(tmp), range.getStart());
+    std::memcpy(tmp + a, " .. ", 4);
+    size_t b = formatPosition(tmp + a + 4, sizeof(tmp) - a - 4, range.getEnd());
+    size_t head = a + 4 + b;
+    tmp[head++] = ':';
+    tmp[head++] = ' ';
+    detail::RangeBytes rb(v, range);
+    size_t bits = rb.fullBytes() * bitPerByte + rb.restBits();
+    if (head + bits > cap) {
+        return 0;
+    }
+    std::memcpy(out, tmp, head);
+    formatBits(out + head, bits, v, range);
+    return head + bits;
+}
+
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "BitPosition.h"
+#include "ByteBufferView.hpp"
+#include "DynamicByteBuffer.hpp"
+#include "Endian.hpp"
+
+/// @file
+/// @brief Canonical prefix-code (Huffman) encoder and table-driven decoder.
+/// @details Codes are assigned canonically from a table of code lengths (one entry per symbol,
+/// 0 = unused): shorter codes first, and symbols in increasing order within a length, as in
+/// DEFLATE. In the LSB-first bit order of `ByteBuffer` the first (most significant) bit of a code
+/// occupies the lowest bit position.
+
+namespace ByteBuffer  {
+
+/// @brief Longest supported code length in bits.
+constexpr unsigned maxHuffmanCodeLength = 24;
+
+/// @brief Canonical code assignment shared by `HuffmanEncoder` and `HuffmanDecoder`.
+class HuffmanCode {
+    public:
+        /// @brief Assign canonical codes for the code lengths `lengths`.
+        /// @throws std::invalid_argument if the table has more than 65536 symbols, a length exceeds
+        /// `maxHuffmanCodeLength`, or the lengths are oversubscribed (no prefix code exists).
+        /// Incomplete codes are accepted; unused bit patterns do not decode.
+        explicit HuffmanCode(const std::vector<uint8_t>& lengths) : len(lengths), rev(lengths.size(), 0) {
+            if (lengths.size() > 65536) {
+                throw std::invalid_argument("HuffmanCode: too many symbols");
+            }
+            uint32_t count[maxHuffmanCodeLength + 1] = {0};
+            for (uint8_t l : lengths) {
+                if (l > maxHuffmanCodeLength) {
+                    throw std::invalid_argument("HuffmanCode: code length too large");
+                }
+                count[l]++;
+            }
+            count[0] = 0;
+            uint32_t next[maxHuffmanCodeLength + 2] = {0};
+            uint64_t code = 0;
+            for (unsigned l = 1; l <= maxHuffmanCodeLength; l++) {
+                code = (code + count[l - 1]) << 1;
+                if (code + count[l] > (static_cast<uint64_t>(1) << l)) {
+                    throw std::invalid_argument("HuffmanCode: code lengths are oversubscribed");
+                }
+                next[l] = static_cast<uint32_t>(code);
+                if (count[l] != 0 && l > maxLen) {
+                    maxLen = static_cast<uint8_t>(l);
+                }
+            }
+            for (size_t s = 0; s < lengths.size(); s++) {
+                uint8_t l = lengths[s];
+                if (l != 0) {
+                    uint32_t c = next[l]++;
+                    uint32_t r = 0;
+                    for (unsigned i = 0; i < l; i++) {
+                        r |= ((c >> i) & 1) << (l - 1 - i);
+                    }
+                    rev[s] = r;
+                }
+            }
+        }
+
+        /// @brief Return the number of symbols in the alphabet.
+        size_t symbols() const { return len.size(); }
+
+        /// @brief Return the code length of `symbol` (0 if unused).
+        uint8_t length(size_t symbol) const { return len[symbol]; }
+
+        /// @brief Return the code of `symbol` bit-reversed, i.e. in the order it is written to the buffer.
+        uint32_t code(size_t symbol) const { return rev[symbol]; }
+
+        /// @brief Return the longest code length in use.
+        uint8_t maxLength() const { return maxLen; }
+
+    private:
+        std::vector<uint8_t> len;
+        std::vector<uint32_t> rev;
+        uint8_t maxLen = 0;
+};
+
+/// @brief Writes symbols with a canonical prefix code.
+class HuffmanEncoder {
+    public:
+        /// @brief Build the encoder for the code lengths `lengths`; see `HuffmanCode`.
+        explicit HuffmanEncoder(const std::vector<uint8_t>& lengths) : code(lengths) {}
+
+        /// @brief Return the canonical code.
+        const HuffmanCode& huffmanCode() const { return code; }
+
+        /// @brief Write `count` symbols into `out` starting at `pos`.
+        /// @details Bits of `out` outside the written codes keep their value.
+        /// @return Position after the last code, or `bitPositionMax` (and nothing written) if a symbol
+        /// has no code or the codes do not fit.
+        BitPosition encode(ByteBufferView out, BitPosition pos, const uint16_t* symbols, size_t count) const {
+            uint64_t bit = pos.getBitIndex();
+            uint64_t total = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (symbols[i] >= code.symbols() || code.length(symbols[i]) == 0) {
+                    return bitPositionMax;
+                }
+                total += code.length(symbols[i]);
+            }
+            if (bit + total > static_cast<uint64_t>(out.size()) * bitPerByte) {
+                return bitPositionMax;
+            }
+            uint8_t* p = out.data() + bit / bitPerByte;
+            unsigned accBits = static_cast<unsigned>(bit % bitPerByte);
+            uint64_t acc = accBits == 0 ? 0 : p[0] & ((1u << accBits) - 1);
+            for (size_t i = 0; i < count; i++) {
+                acc |= static_cast<uint64_t>(code.code(symbols[i])) << accBits;
+                accBits += code.length(symbols[i]);
+                if (accBits >= 32) {
+                    detail::storeLe32(p, static_cast<uint32_t>(acc));
+                    p += 4;
+                    acc >>= 32;
+                    accBits -= 32;
+                }
+            }
+            for (; accBits >= bitPerByte; accBits -= bitPerByte, acc >>= bitPerByte) {
+                *p++ = static_cast<uint8_t>(acc);
+            }
+            if (accBits != 0) {
+                uint8_t m = static_cast<uint8_t>((1u << accBits) - 1);
+                *p = static_cast<uint8_t>((*p & ~m) | (acc & m));
+            }
+            uint64_t end = bit + total;
+            return BitPosition(static_cast<uint32_t>(end / bitPerByte), static_cast<uint8_t>(end % bitPerByte));
+        }
+
+        /// @brief Append `count` symbols to `out`.
+        /// @return False (and nothing appended) if a symbol has no code.
+        bool encode(DynamicByteBuffer& out, const uint16_t* symbols, size_t count) const {
+            for (size_t i = 0; i < count; i++) {
+                if (symbols[i] >= code.symbols() || code.length(symbols[i]) == 0) {
+                    return false;
+                }
+            }
+            for (size_t i = 0; i < count; i++) {
+                out.append(code.code(symbols[i]), code.length(symbols[i]));
+            }
+            return true;
+        }
+
+    private:
+        HuffmanCode code;
+};
+
+/// @brief Decodes a canonical prefix code with multi-level lookup tables.
+/// @details The primary table is indexed by the next `primaryBits` input bits. An entry holds
+/// either one symbol, two symbols whose codes together fit into the lookup, or a link to a
+/// secondary table for longer codes. Input bits are read with one unaligned 64-bit load per
+/// refill, which serves several lookups.
+class HuffmanDecoder {
+    public:
+        /// @brief Build the decoder for the code lengths `lengths`; see `HuffmanCode`.
+        /// @param primaryBits Index width of the primary table (1..16).
+        explicit HuffmanDecoder(const std::vector<uint8_t>& lengths, unsigned primaryBits = 11) : code(lengths) {
+            if (primaryBits < 1 || primaryBits > 16) {
+                throw std::invalid_argument("HuffmanDecoder: primary table width must be 1..16 bits");
+            }
+            primary = primaryBits;
+            build();
+        }
+
+        /// @brief Return the canonical code.
+        const HuffmanCode& huffmanCode() const { return code; }
+
+        /// @brief Decode up to `count` symbols from `in` starting at `pos`.
+        /// @details Decoding stops early at the end of the input or at a bit pattern that is not a code.
+        /// @param end Receives the position after the last decoded code, if not null.
+        /// @return Number of symbols written to `out`.
+        size_t decode(ConstByteBufferView in, BitPosition pos, uint16_t* out, size_t count, BitPosition* end = nullptr) const {
+            const uint8_t* p = in.data();
+            uint64_t totalBits = static_cast<uint64_t>(in.size()) * bitPerByte;
+            uint64_t bit = pos.getBitIndex();
+            const uint64_t primaryMask = (static_cast<uint64_t>(1) << primary) - 1;
+            size_t n = 0;
+            bool stop = bit >= totalBits;
+            while (!stop && n < count) {
+                // refill: at least 56 valid bits
+                uint64_t acc;
+                size_t byte = static_cast<size_t>(bit / bitPerByte);
+                if (byte + 8 <= in.size()) {
+                    acc = detail::loadLe64(p + byte);
+                } else {
+                    acc = detail::loadLePartial(p + byte, in.size() - byte);
+                }
+                acc >>= bit % bitPerByte;
+                unsigned avail = 56;
+                while (avail >= maxLookupBits && n < count) {
+                    const Entry* e = &table[acc & primaryMask];
+                    if (e->kind == link) {
+                        e = &table[e->link() + ((acc >> primary) & ((1u << e->subBits) - 1))];
+                    }
+                    if (e->kind == invalid || bit + e->len0 > totalBits) {
+                        stop = true;
+                        break;
+                    }
+                    if (e->kind == pair && n + 1 < count && bit + e->len <= totalBits) {
+                        out[n++] = e->sym0;
+                        out[n++] = e->sym1;
+                        bit += e->len;
+                        acc >>= e->len;
+                        avail -= e->len;
+                    } else {
+                        out[n++] = e->sym0;
+                        bit += e->len0;
+                        acc >>= e->len0;
+                        avail -= e->len0;
+                    }
+                    if (bit >= totalBits) {
+                        stop = true;
+                        break;
+                    }
+                }
+            }
+            if (end) {
+                *end = BitPosition(static_cast<uint32_t>(bit / bitPerByte), static_cast<uint8_t>(bit % bitPerByte));
+            }
+            return n;
+        }
+
+    private:
+        enum Kind : uint8_t { invalid = 0, single = 1, pair = 2, link = 3 };
+
+        /// @brief Table entry; for links, `sym0` and `sym1` hold the offset of the secondary table.
+        struct Entry {
+            uint16_t sym0;
+            uint16_t sym1;
+            uint8_t len0;       ///< Bits of the first symbol.
+            uint8_t len;        ///< Bits of all symbols of the entry.
+            uint8_t kind;
+            uint8_t subBits;    ///< Index width of the linked secondary table.
+
+            uint32_t link() const { return static_cast<uint32_t>(sym0) | (static_cast<uint32_t>(sym1) << 16); }
+        };
+
+        void build() {
+            size_t primarySize = static_cast<size_t>(1) << primary;
+            table.assign(primarySize, Entry{0, 0, 0, 0, invalid, 0});
+            maxLookupBits = code.maxLength() > primary ? code.maxLength() : primary;
+            // short codes fill every primary slot they prefix
+            for (size_t s = 0; s < code.symbols(); s++) {
+                uint8_t l = code.length(s);
+                if (l == 0 || l > primary) {
+                    continue;
+                }
+                for (size_t i = code.code(s); i < primarySize; i += static_cast<size_t>(1) << l) {
+                    table[i] = Entry{static_cast<uint16_t>(s), 0, l, l, single, 0};
+                }
+            }
+            // long codes go to secondary tables, one per primary prefix, sized by their longest code
+            std::vector<uint8_t> subBits(primarySize, 0);
+            for (size_t s = 0; s < code.symbols(); s++) {
+                uint8_t l = code.length(s);
+                if (l > primary) {
+                    size_t prefix = code.code(s) & (primarySize - 1);
+                    uint8_t w = static_cast<uint8_t>(l - primary);
+                    subBits[prefix] = w > subBits[prefix] ? w : subBits[prefix];
+                }
+            }
+            for (size_t prefix = 0; prefix < primarySize; prefix++) {
+                if (subBits[prefix] != 0) {
+                    uint32_t offset = static_cast<uint32_t>(table.size());
+                    table[prefix] = Entry{static_cast<uint16_t>(offset), static_cast<uint16_t>(offset >> 16), 0, 0, link, subBits[prefix]};
+                    table.resize(table.size() + (static_cast<size_t>(1) << subBits[prefix]), Entry{0, 0, 0, 0, invalid, 0});
+                }
+            }
+            for (size_t s = 0; s < code.symbols(); s++) {
+                uint8_t l = code.length(s);
+                if (l <= primary) {
+                    continue;
+                }
+                const Entry& ln = table[code.code(s) & (primarySize - 1)];
+                uint32_t sub = code.code(s) >> primary;
+                unsigned subLen = l - primary;
+                for (size_t i = sub; i < (static_cast<size_t>(1) << ln.subBits); i += static_cast<size_t>(1) << subLen) {
+                    table[ln.link() + i] = Entry{static_cast<uint16_t>(s), 0, l, l, single, 0};
+                }
+            }
+            // pair up a short code with a second short code that fits into the remaining index bits
+            std::vector<Entry> singles(table.begin(), table.begin() + static_cast<std::ptrdiff_t>(primarySize));
+            for (size_t i = 0; i < primarySize; i++) {
+                const Entry& a = singles[i];
+                if (a.kind != single || a.len0 >= primary) {
+                    continue;
+                }
+                const Entry& b = singles[i >> a.len0];
+                if (b.kind == single && a.len0 + b.len0 <= primary) {
+                    table[i] = Entry{a.sym0, b.sym0, a.len0, static_cast<uint8_t>(a.len0 + b.len0), pair, 0};
+                }
+            }
+        }
+
+        HuffmanCode code;
+        unsigned primary = 11;
+        unsigned maxLookupBits = 11;
+        std::vector<Entry> table;
+};
+
+}
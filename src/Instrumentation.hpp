@@ -0,0 +1,173 @@
+#pragma once
+
+/// @file
+/// @brief Optional access statistics for `ByteBuffer`.
+/// @details Compile with `BYTEBUFFER_INSTRUMENTATION` defined (for the whole program) to count
+/// accesses and to get `snapshot()`/`reset()`. Without it the `BYTEBUFFER_RECORD_*` hooks in
+/// `ByteBuffer.hpp` expand to nothing, so uninstrumented builds carry no overhead.
+
+#ifdef BYTEBUFFER_INSTRUMENTATION
+#define BYTEBUFFER_RECORD_GET(width, pos, bitCount) ::ByteBuffer::instrumentation::recordAccess(false, width, pos, bitCount)
+#define BYTEBUFFER_RECORD_SET(width, pos, bitCount) ::ByteBuffer::instrumentation::recordAccess(true, width, pos, bitCount)
+#define BYTEBUFFER_RECORD_PROXY() ::ByteBuffer::instrumentation::record(::ByteBuffer::instrumentation::Counter::proxyConstructions)
+#define BYTEBUFFER_RECORD_TRUNCATION() ::ByteBuffer::instrumentation::record(::ByteBuffer::instrumentation::Counter::truncations)
+#else
+#define BYTEBUFFER_RECORD_GET(width, pos, bitCount) ((void)0)
+#define BYTEBUFFER_RECORD_SET(width, pos, bitCount) ((void)0)
+#define BYTEBUFFER_RECORD_PROXY() ((void)0)
+#define BYTEBUFFER_RECORD_TRUNCATION() ((void)0)
+#endif
+
+#ifdef BYTEBUFFER_INSTRUMENTATION
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "BitPosition.h"
+
+namespace ByteBuffer  {
+namespace instrumentation  {
+
+/// @brief Snapshot of all access counters, summed over every thread.
+/// @details Index `i` of the per-width arrays counts accesses with a value type of `1 << i` bytes.
+struct AccessStats {
+    std::array<uint64_t, 4> getCalls{};     ///< `get` calls by value width (1, 2, 4, 8 bytes).
+    std::array<uint64_t, 4> setCalls{};     ///< `set` calls by value width (1, 2, 4, 8 bytes).
+    uint64_t proxyConstructions = 0;        ///< `Bit`/`Bits` proxies created by `at()`.
+    uint64_t bytesTouched = 0;              ///< Bytes spanned by all `get`/`set` calls.
+    uint64_t alignedAccesses = 0;           ///< Accesses starting on a byte boundary with a whole number of bytes.
+    uint64_t unalignedAccesses = 0;         ///< All other accesses.
+    uint64_t truncations = 0;               ///< Accesses shortened by `fieldWidth`.
+};
+
+/// @brief Identifies a single counter of a shard.
+enum class Counter : size_t {
+    get8, get16, get32, get64,
+    set8, set16, set32, set64,
+    proxyConstructions,
+    bytesTouched,
+    alignedAccesses,
+    unalignedAccesses,
+    truncations,
+    count
+};
+
+namespace detail {
+
+/// @brief Counters of one thread; only the owning thread writes, snapshots read concurrently.
+struct Shard {
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::count)> counters{};
+};
+
+/// @brief Registry of all shards; shards outlive their threads so no counts are lost.
+class Registry {
+    public:
+        static Registry& instance() {
+            static Registry registry;
+            return registry;
+        }
+        std::shared_ptr<Shard> add() {
+            std::shared_ptr<Shard> shard = std::make_shared<Shard>();
+            std::lock_guard<std::mutex> lock(mtx);
+            shards.push_back(shard);
+            return shard;
+        }
+        template <typename F>
+        void forEach(F f) {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (const std::shared_ptr<Shard>& s : shards) {
+                f(*s);
+            }
+        }
+    private:
+        std::mutex mtx;
+        std::vector<std::shared_ptr<Shard>> shards;
+};
+
+inline Shard& localShard() {
+    static thread_local std::shared_ptr<Shard> shard = Registry::instance().add();
+    return *shard;
+}
+
+inline size_t widthIndex(size_t width) {
+    return width >= 8 ? 3 : width >= 4 ? 2 : width >= 2 ? 1 : 0;
+}
+
+}
+
+/// @brief Add `n` to counter `c` of the calling thread's shard.
+inline void record(Counter c, uint64_t n = 1) {
+    std::atomic<uint64_t>& cnt = detail::localShard().counters[static_cast<size_t>(c)];
+    // single writer per shard: a plain load/store pair avoids a locked instruction
+    cnt.store(cnt.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/// @brief Record a `get` or `set` of `bitCount` bits starting at `pos` with a value type of `width` bytes.
+inline void recordAccess(bool isSet, size_t width, BitPosition pos, uint32_t bitCount) {
+    size_t base = static_cast<size_t>(isSet ? Counter::set8 : Counter::get8);
+    record(static_cast<Counter>(base + detail::widthIndex(width)));
+    record(Counter::bytesTouched, (pos.getBitPos() + bitCount + bitPerByte - 1) / bitPerByte);
+    if (pos.getBitPos() == 0 && bitCount % bitPerByte == 0) {
+        record(Counter::alignedAccesses);
+    } else {
+        record(Counter::unalignedAccesses);
+    }
+}
+
+/// @brief Sum the counters of all threads.
+inline AccessStats snapshot() {
+    std::array<uint64_t, static_cast<size_t>(Counter::count)> sum{};
+    detail::Registry::instance().forEach([&sum](const detail::Shard& s) {
+        for (size_t i = 0; i < sum.size(); i++) {
+            sum[i] += s.counters[i].load(std::memory_order_relaxed);
+        }
+    });
+    AccessStats stats;
+    for (size_t i = 0; i < 4; i++) {
+        stats.getCalls[i] = sum[static_cast<size_t>(Counter::get8) + i];
+        stats.setCalls[i] = sum[static_cast<size_t>(Counter::set8) + i];
+    }
+    stats.proxyConstructions = sum[static_cast<size_t>(Counter::proxyConstructions)];
+    stats.bytesTouched = sum[static_cast<size_t>(Counter::bytesTouched)];
+    stats.alignedAccesses = sum[static_cast<size_t>(Counter::alignedAccesses)];
+    stats.unalignedAccesses = sum[static_cast<size_t>(Counter::unalignedAccesses)];
+    stats.truncations = sum[static_cast<size_t>(Counter::truncations)];
+    return stats;
+}
+
+/// @brief Reset the counters of all threads to zero.
+/// @note Increments racing with the reset may be lost.
+inline void reset() {
+    detail::Registry::instance().forEach([](detail::Shard& s) {
+        for (std::atomic<uint64_t>& c : s.counters) {
+            c.store(0, std::memory_order_relaxed);
+        }
+    });
+}
+
+/// @brief Write `stats` as one "name value" pair per line.
+inline std::ostream& operator<<(std::ostream& os, const AccessStats& stats) {
+    static const char* const widths[4] = {"8", "16", "32", "64"};
+    for (size_t i = 0; i < 4; i++) {
+        os << "get" << widths[i] << " " << stats.getCalls[i] << "\n";
+    }
+    for (size_t i = 0; i < 4; i++) {
+        os << "set" << widths[i] << " " << stats.setCalls[i] << "\n";
+    }
+    return os << "proxyConstructions " << stats.proxyConstructions << "\n"
+              << "bytesTouched " << stats.bytesTouched << "\n"
+              << "alignedAccesses " << stats.alignedAccesses << "\n"
+              << "unalignedAccesses " << stats.unalignedAccesses << "\n"
+              << "truncations " << stats.truncations << "\n";
+}
+
+}
+}
+
+#endif
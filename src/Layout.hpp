@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ByteBuffer.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Compile-time description of a bit field of a message layout.
+/// @details Name a field by deriving an empty tag type from it, e.g.
+/// `struct Version : ByteBuffer::Field<0, 4, uint8_t> {};`, and list the tags in a `Layout`.
+/// Values use the bit order of `ByteBuffer::get`: the LSB of the value is the bit at `StartBit`.
+/// A field of signed `T` holds a two's complement value of `Width` bits and is sign-extended on reads.
+/// @tparam StartBit Absolute bit index of the first bit.
+/// @tparam Width Number of bits (1..64, at most the width of `T`).
+/// @tparam T Integral value type.
+template <uint32_t StartBit, uint8_t Width, typename T = uint32_t>
+struct Field {
+    static_assert(std::is_integral<T>::value,"only integral types are allowed");
+    static_assert(Width >= 1 && Width <= 64, "field width must be 1..64 bits");
+    static_assert(Width <= sizeof(T) * bitPerByte, "field wider than its value type");
+
+    using type = T;
+    static constexpr uint32_t start = StartBit;
+    static constexpr uint8_t width = Width;
+
+    /// @brief Return the field as a `BitRange`.
+    static constexpr BitRange range() {
+        return BitRange(BitPosition(StartBit), BitPosition(StartBit + Width - 1));
+    }
+};
+
+namespace detail {
+
+template <typename F, typename... Fs>
+struct ContainsField : std::false_type {};
+
+template <typename F, typename First, typename... Rest>
+struct ContainsField<F, First, Rest...> : std::conditional<std::is_same<F, First>::value, std::true_type, ContainsField<F, Rest...>>::type {};
+
+/// @brief Check that every field ends inside a buffer of `Bytes` bytes.
+template <size_t Bytes, typename... Fs>
+constexpr bool fieldsFit() {
+    constexpr uint64_t ends[] = {0, (static_cast<uint64_t>(Fs::start) + Fs::width)...};
+    for (size_t i = 1; i < sizeof(ends) / sizeof(ends[0]); i++) {
+        if (ends[i] > static_cast<uint64_t>(Bytes) * bitPerByte) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Check that no two fields share a bit.
+template <typename... Fs>
+constexpr bool fieldsDisjoint() {
+    constexpr uint64_t starts[] = {0, static_cast<uint64_t>(Fs::start)...};
+    constexpr uint64_t ends[] = {0, (static_cast<uint64_t>(Fs::start) + Fs::width)...};
+    for (size_t i = 1; i < sizeof(starts) / sizeof(starts[0]); i++) {
+        for (size_t j = i + 1; j < sizeof(starts) / sizeof(starts[0]); j++) {
+            if (starts[i] < ends[j] && starts[j] < ends[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+/// @brief Typed view over a `ByteBuffer<Bytes>` with the named fields `Fields...`.
+/// @details Field bounds and overlaps are checked at compile time. Single fields are read and
+/// written with `detail::readField`/`writeField` instead of a bit loop. `decodeAll()` and
+/// `encodeAll()` load the buffer into 64-bit words once and extract or merge every field from
+/// those words, so each word is read (and written) only once.
+/// @tparam Bytes Size of the underlying buffer.
+/// @tparam Fields Field tags derived from `Field`.
+template <size_t Bytes, typename... Fields>
+class Layout {
+        static_assert(sizeof...(Fields) > 0, "a layout needs at least one field");
+        static_assert(detail::fieldsFit<Bytes, Fields...>(), "a field exceeds the buffer");
+        static_assert(detail::fieldsDisjoint<Fields...>(), "fields overlap");
+
+        static constexpr size_t words = (Bytes + 7) / 8 + 1;
+
+    public:
+        /// @brief Values of all fields in declaration order.
+        using Values = std::tuple<typename Fields::type...>;
+
+        /// @brief Construct a view of `b`; the buffer must outlive the view.
+        explicit Layout(ByteBuffer<Bytes>& b) : buf(b) {}
+
+        /// @brief Return the value of field `F`.
+        template <typename F>
+        typename F::type get() const {
+            static_assert(detail::ContainsField<F, Fields...>::value, "field is not part of this layout");
+            return toValue<F>(detail::readField(buf.getData(), Bytes, F::start, F::width));
+        }
+
+        /// @brief Write `value` into field `F`; bits of `value` above the field width are ignored.
+        template <typename F>
+        void set(typename F::type value) {
+            static_assert(detail::ContainsField<F, Fields...>::value, "field is not part of this layout");
+            detail::writeField(buf.data(), Bytes, F::start, static_cast<uint64_t>(value), F::width);
+        }
+
+        /// @brief Return the values of all fields, reading every buffer word once.
+        Values decodeAll() const {
+            uint64_t w[words];
+            loadWords(w);
+            return Values(toValue<Fields>(extractWord<Fields>(w))...);
+        }
+
+        /// @brief Write the values of all fields, reading and writing every buffer word once.
+        /// @details Bits not covered by a field keep their value.
+        void encodeAll(const Values& values) {
+            uint64_t w[words];
+            loadWords(w);
+            encodeFields(w, values, std::make_index_sequence<sizeof...(Fields)>());
+            storeWords(w);
+        }
+
+    private:
+        /// @brief Number of buffer bytes held by word `i`; the extra last word is all zero padding.
+        static constexpr size_t wordBytes(size_t i) {
+            return i * 8 >= Bytes ? 0 : (Bytes - i * 8 < 8 ? Bytes - i * 8 : 8);
+        }
+
+        /// @brief Load the buffer into the little-endian word array `w`, zero-padded.
+        void loadWords(uint64_t* w) const {
+            for (size_t i = 0; i < words; i++) {
+                w[i] = wordBytes(i) == 0 ? 0 : detail::loadLePartial(buf.getData() + i * 8, wordBytes(i));
+            }
+        }
+
+        /// @brief Store the little-endian word array `w` back into the buffer.
+        void storeWords(const uint64_t* w) {
+            for (size_t i = 0; wordBytes(i) != 0; i++) {
+                detail::storeLePartial(buf.data() + i * 8, w[i], wordBytes(i));
+            }
+        }
+
+        /// @brief Extract `F` from the little-endian word array `w`.
+        template <typename F>
+        static uint64_t extractWord(const uint64_t* w) {
+            constexpr size_t idx = F::start / 64;
+            constexpr unsigned shift = F::start % 64;
+            uint64_t v = shift == 0 ? w[idx] : (w[idx] >> shift) | (w[idx + 1] << ((64 - shift) % 64));
+            return v & detail::bitMaskTables().lowMask[F::width];
+        }
+
+        /// @brief Convert the `F::width` raw bits of `F` to its value type, sign-extending signed types.
+        template <typename F>
+        static typename F::type toValue(uint64_t raw) {
+            if (std::is_signed<typename F::type>::value) {
+                uint64_t sign = static_cast<uint64_t>(1) << (F::width - 1);
+                raw = (raw ^ sign) - sign;
+            }
+            return static_cast<typename F::type>(raw);
+        }
+
+        /// @brief Merge `value` into `F` inside the little-endian word array `w`.
+        template <typename F>
+        static void insertWord(uint64_t* w, uint64_t value) {
+            constexpr size_t idx = F::start / 64;
+            constexpr unsigned shift = F::start % 64;
+            uint64_t mask = detail::bitMaskTables().lowMask[F::width];
+            value &= mask;
+            w[idx] = (w[idx] & ~(mask << shift)) | (value << shift);
+            if (shift != 0) {
+                unsigned hiShift = (64 - shift) % 64;
+                w[idx + 1] = (w[idx + 1] & ~(mask >> hiShift)) | (value >> hiShift);
+            }
+        }
+
+        template <size_t... I>
+        static void encodeFields(uint64_t* w, const Values& values, std::index_sequence<I...>) {
+            int expand[] = {0, (insertWord<Fields>(w, static_cast<uint64_t>(std::get<I>(values))), 0)...};
+            (void)expand;
+        }
+
+        ByteBuffer<Bytes>& buf;
+};
+
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "BitMask.hpp"
+#include "BitPosition.h"
+#include "ByteBufferView.hpp"
+
+/// @file
+/// @brief Morton (Z-order) keys of 2, 3 and 4 coordinates of 32 bits.
+/// @details Bit `i * D + d` of a key of `D` coordinates is bit `i` of coordinate `d`, so the first
+/// coordinate occupies the lowest bit. Keys are 64, 96 and 128 bits wide and are stored in the
+/// LSB-first bit order of `ByteBuffer` (the key LSB at the given position). Bits are spread with
+/// `pdep`/`pext` when BMI2 is available and with shift-and-mask sequences otherwise.
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief Spread and compact one coordinate chunk for `D` dimensions.
+/// @details A chunk is `chunkBits` coordinate bits, spread to every `D`-th bit of a 64-bit word.
+template <unsigned D>
+struct MortonChunk;
+
+template <>
+struct MortonChunk<2> {
+    static constexpr unsigned chunkBits = 32;
+    static constexpr uint64_t mask = 0x5555555555555555ull;
+
+    static uint64_t spread(uint64_t x) {
+#if defined(__BMI2__)
+        return _pdep_u64(x, mask);
+#else
+        x &= 0xffffffffull;
+        x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+        x = (x | (x << 8)) & 0x00ff00ff00ff00ffull;
+        x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        return (x | (x << 1)) & mask;
+#endif
+    }
+
+    static uint64_t compact(uint64_t x) {
+#if defined(__BMI2__)
+        return _pext_u64(x, mask);
+#else
+        x &= mask;
+        x = (x | (x >> 1)) & 0x3333333333333333ull;
+        x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0full;
+        x = (x | (x >> 4)) & 0x00ff00ff00ff00ffull;
+        x = (x | (x >> 8)) & 0x0000ffff0000ffffull;
+        return (x | (x >> 16)) & 0xffffffffull;
+#endif
+    }
+};
+
+template <>
+struct MortonChunk<3> {
+    static constexpr unsigned chunkBits = 16;
+    static constexpr uint64_t mask = 0x0000249249249249ull;
+
+    static uint64_t spread(uint64_t x) {
+#if defined(__BMI2__)
+        return _pdep_u64(x, mask);
+#else
+        x &= 0xffffull;
+        x = (x | (x << 16)) & 0x00000000ff0000ffull;
+        x = (x | (x << 8)) & 0x000000f00f00f00full;
+        x = (x | (x << 4)) & 0x00000c30c30c30c3ull;
+        return (x | (x << 2)) & mask;
+#endif
+    }
+
+    static uint64_t compact(uint64_t x) {
+#if defined(__BMI2__)
+        return _pext_u64(x, mask);
+#else
+        x &= mask;
+        x = (x | (x >> 2)) & 0x00000c30c30c30c3ull;
+        x = (x | (x >> 4)) & 0x000000f00f00f00full;
+        x = (x | (x >> 8)) & 0x00000000ff0000ffull;
+        return (x | (x >> 16)) & 0xffffull;
+#endif
+    }
+};
+
+template <>
+struct MortonChunk<4> {
+    static constexpr unsigned chunkBits = 16;
+    static constexpr uint64_t mask = 0x1111111111111111ull;
+
+    static uint64_t spread(uint64_t x) {
+#if defined(__BMI2__)
+        return _pdep_u64(x, mask);
+#else
+        x &= 0xffffull;
+        x = (x | (x << 24)) & 0x000000ff000000ffull;
+        x = (x | (x << 12)) & 0x000f000f000f000full;
+        x = (x | (x << 6)) & 0x0303030303030303ull;
+        return (x | (x << 3)) & mask;
+#endif
+    }
+
+    static uint64_t compact(uint64_t x) {
+#if defined(__BMI2__)
+        return _pext_u64(x, mask);
+#else
+        x &= mask;
+        x = (x | (x >> 3)) & 0x0303030303030303ull;
+        x = (x | (x >> 6)) & 0x000f000f000f000full;
+        x = (x | (x >> 12)) & 0x000000ff000000ffull;
+        return (x | (x >> 24)) & 0xffffull;
+#endif
+    }
+};
+
+/// @brief Write the key of the `D` coordinates `c` at absolute bit `bit` of the `size` bytes at `p`.
+template <unsigned D>
+void writeMorton(uint8_t* p, size_t size, uint64_t bit, const uint32_t* c) {
+    using C = MortonChunk<D>;
+    for (unsigned k = 0; k < 32 / C::chunkBits; k++) {
+        uint64_t w = 0;
+        for (unsigned d = 0; d < D; d++) {
+            w |= C::spread(c[d] >> (k * C::chunkBits)) << d;
+        }
+        writeField(p, size, bit + k * C::chunkBits * D, w, C::chunkBits * D);
+    }
+}
+
+/// @brief Read the key of `D` coordinates at absolute bit `bit` of the `size` bytes at `p` into `c`.
+template <unsigned D>
+void readMorton(const uint8_t* p, size_t size, uint64_t bit, uint32_t* c) {
+    using C = MortonChunk<D>;
+    for (unsigned d = 0; d < D; d++) {
+        c[d] = 0;
+    }
+    for (unsigned k = 0; k < 32 / C::chunkBits; k++) {
+        uint64_t w = readField(p, size, bit + k * C::chunkBits * D, C::chunkBits * D);
+        for (unsigned d = 0; d < D; d++) {
+            c[d] |= static_cast<uint32_t>(C::compact(w >> d) << (k * C::chunkBits));
+        }
+    }
+}
+
+/// @brief Check that `count` keys of `D` coordinates starting at `pos` fit into `size` bytes.
+template <unsigned D>
+bool mortonFits(size_t size, BitPosition pos, size_t count) {
+    return pos.getBitIndex() + static_cast<uint64_t>(count) * 32 * D <= static_cast<uint64_t>(size) * bitPerByte;
+}
+
+}
+
+/// @brief Return the 64-bit Morton key of `x` and `y`.
+inline uint64_t morton2(uint32_t x, uint32_t y) {
+    return detail::MortonChunk<2>::spread(x) | (detail::MortonChunk<2>::spread(y) << 1);
+}
+
+/// @brief Split the 64-bit Morton key `key` into `x` and `y`.
+inline void morton2Decode(uint64_t key, uint32_t& x, uint32_t& y) {
+    x = static_cast<uint32_t>(detail::MortonChunk<2>::compact(key));
+    y = static_cast<uint32_t>(detail::MortonChunk<2>::compact(key >> 1));
+}
+
+/// @brief Write the 64-bit key of (`x`, `y`) into `buf` at `pos`.
+/// @return False (and nothing written) if the key does not fit.
+inline bool interleave(ByteBufferView buf, BitPosition pos, uint32_t x, uint32_t y) {
+    if (!detail::mortonFits<2>(buf.size(), pos, 1)) {
+        return false;
+    }
+    const uint32_t c[2] = {x, y};
+    detail::writeMorton<2>(buf.data(), buf.size(), pos.getBitIndex(), c);
+    return true;
+}
+
+/// @brief Write the 96-bit key of (`x`, `y`, `z`) into `buf` at `pos`.
+/// @return False (and nothing written) if the key does not fit.
+inline bool interleave(ByteBufferView buf, BitPosition pos, uint32_t x, uint32_t y, uint32_t z) {
+    if (!detail::mortonFits<3>(buf.size(), pos, 1)) {
+        return false;
+    }
+    const uint32_t c[3] = {x, y, z};
+    detail::writeMorton<3>(buf.data(), buf.size(), pos.getBitIndex(), c);
+    return true;
+}
+
+/// @brief Write the 128-bit key of (`x`, `y`, `z`, `w`) into `buf` at `pos`.
+/// @return False (and nothing written) if the key does not fit.
+inline bool interleave(ByteBufferView buf, BitPosition pos, uint32_t x, uint32_t y, uint32_t z, uint32_t w) {
+    if (!detail::mortonFits<4>(buf.size(), pos, 1)) {
+        return false;
+    }
+    const uint32_t c[4] = {x, y, z, w};
+    detail::writeMorton<4>(buf.data(), buf.size(), pos.getBitIndex(), c);
+    return true;
+}
+
+/// @brief Read the 64-bit key at `pos` in `buf` into `x` and `y`.
+/// @return False (and the outputs unchanged) if the key does not lie inside `buf`.
+inline bool deinterleave(ConstByteBufferView buf, BitPosition pos, uint32_t& x, uint32_t& y) {
+    if (!detail::mortonFits<2>(buf.size(), pos, 1)) {
+        return false;
+    }
+    uint32_t c[2];
+    detail::readMorton<2>(buf.data(), buf.size(), pos.getBitIndex(), c);
+    x = c[0];
+    y = c[1];
+    return true;
+}
+
+/// @brief Read the 96-bit key at `pos` in `buf` into `x`, `y` and `z`.
+/// @return False (and the outputs unchanged) if the key does not lie inside `buf`.
+inline bool deinterleave(ConstByteBufferView buf, BitPosition pos, uint32_t& x, uint32_t& y, uint32_t& z) {
+    if (!detail::mortonFits<3>(buf.size(), pos, 1)) {
+        return false;
+    }
+    uint32_t c[3];
+    detail::readMorton<3>(buf.data(), buf.size(), pos.getBitIndex(), c);
+    x = c[0];
+    y = c[1];
+    z = c[2];
+    return true;
+}
+
+/// @brief Read the 128-bit key at `pos` in `buf` into `x`, `y`, `z` and `w`.
+/// @return False (and the outputs unchanged) if the key does not lie inside `buf`.
+inline bool deinterleave(ConstByteBufferView buf, BitPosition pos, uint32_t& x, uint32_t& y, uint32_t& z, uint32_t& w) {
+    if (!detail::mortonFits<4>(buf.size(), pos, 1)) {
+        return false;
+    }
+    uint32_t c[4];
+    detail::readMorton<4>(buf.data(), buf.size(), pos.getBitIndex(), c);
+    x = c[0];
+    y = c[1];
+    z = c[2];
+    w = c[3];
+    return true;
+}
+
+/// @brief Write the keys of `count` points back to back into `buf`, the first at `pos`.
+/// @tparam D Number of coordinates (2, 3 or 4).
+/// @param coords `D` arrays of `count` coordinates each (structure of arrays).
+/// @return False (and nothing written) if the keys do not fit.
+template <unsigned D>
+bool interleaveBatch(ByteBufferView buf, BitPosition pos, const uint32_t* const (&coords)[D], size_t count) {
+    if (!detail::mortonFits<D>(buf.size(), pos, count)) {
+        return false;
+    }
+    uint64_t bit = pos.getBitIndex();
+    for (size_t i = 0; i < count; i++, bit += 32 * D) {
+        uint32_t c[D];
+        for (unsigned d = 0; d < D; d++) {
+            c[d] = coords[d][i];
+        }
+        detail::writeMorton<D>(buf.data(), buf.size(), bit, c);
+    }
+    return true;
+}
+
+/// @brief Read `count` keys stored back to back in `buf`, the first at `pos`.
+/// @tparam D Number of coordinates (2, 3 or 4).
+/// @param coords `D` arrays receiving `count` coordinates each.
+/// @return False (and nothing read) if the keys do not lie inside `buf`.
+template <unsigned D>
+bool deinterleaveBatch(ConstByteBufferView buf, BitPosition pos, uint32_t* const (&coords)[D], size_t count) {
+    if (!detail::mortonFits<D>(buf.size(), pos, count)) {
+        return false;
+    }
+    uint64_t bit = pos.getBitIndex();
+    for (size_t i = 0; i < count; i++, bit += 32 * D) {
+        uint32_t c[D];
+        detail::readMorton<D>(buf.data(), buf.size(), bit, c);
+        for (unsigned d = 0; d < D; d++) {
+            coords[d][i] = c[d];
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "ByteBuffer.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Conjunction of field predicates compiled for fast evaluation over `ByteBuffer<Bytes>`.
+/// @details Equality predicates are merged into one mask and one compare value per 64-bit buffer
+/// word, so they cost one load, AND and compare per touched word no matter how many fields they
+/// cover (with AVX2, four words per step). Range and set predicates are checked afterwards on the
+/// extracted field value. Field values use the bit order of `ByteBuffer::get`. Building the filter
+/// allocates; evaluating it does not.
+/// @tparam Bytes Size of the buffers the filter is evaluated on.
+template <size_t Bytes>
+class PacketFilter {
+        static constexpr size_t words = (Bytes + 7) / 8;
+
+    public:
+        /// @brief Construct a filter without predicates; it matches every buffer.
+        PacketFilter() : mask(words, 0), value(words, 0) {}
+
+        /// @brief Require the field `range` to equal `v`.
+        /// @details If `v` does not fit in the field, the filter never matches.
+        /// @throws std::invalid_argument if the range is wider than 64 bits.
+        /// @throws std::out_of_range if the range does not lie inside the buffer.
+        PacketFilter& equals(BitRange range, uint64_t v) {
+            FieldRef f = field(range);
+            if ((v & ~f.mask) != 0) {
+                never = true;
+                return *this;
+            }
+            addWord(f.word, f.mask << f.shift, v << f.shift);
+            if (f.shift + f.width > 64) {
+                addWord(f.word + 1, f.mask >> (64 - f.shift), v >> (64 - f.shift));
+            }
+            return *this;
+        }
+
+        /// @brief Require the field `range` to lie in `lo..hi` (inclusive).
+        /// @throws Like `equals`.
+        PacketFilter& inRange(BitRange range, uint64_t lo, uint64_t hi) {
+            ranges.push_back(RangePredicate{field(range), lo, hi});
+            return *this;
+        }
+
+        /// @brief Require the field `range` to equal one of `values`.
+        /// @throws Like `equals`.
+        PacketFilter& inSet(BitRange range, std::vector<uint64_t> values) {
+            std::sort(values.begin(), values.end());
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+            sets.push_back(SetPredicate{field(range), std::move(values)});
+            return *this;
+        }
+
+        /// @brief Require the field `range` to equal one of `values`.
+        /// @throws Like `equals`.
+        PacketFilter& inSet(BitRange range, std::initializer_list<uint64_t> values) {
+            return inSet(range, std::vector<uint64_t>(values));
+        }
+
+        /// @brief Return whether `b` satisfies all predicates.
+        bool matches(const ByteBuffer<Bytes>& b) const {
+            const uint8_t* p = b.getData();
+            return !never && equalWords(p) && extraPredicates(p);
+        }
+
+        /// @brief Evaluate the filter on `count` buffers.
+        /// @param bufs Array of `count` buffers.
+        /// @param bitmap Receives one bit per buffer (bit `i % 64` of word `i / 64`), set on a
+        /// match; must hold `(count + 63) / 64` words.
+        /// @return Number of matching buffers.
+        size_t matchBatch(const ByteBuffer<Bytes>* bufs, size_t count, uint64_t* bitmap) const {
+            return batch(count, bitmap, [bufs](size_t i) { return bufs[i].getData(); });
+        }
+
+        /// @brief Evaluate the filter on `count` buffers given by pointers; see the array overload.
+        size_t matchBatch(const ByteBuffer<Bytes>* const* bufs, size_t count, uint64_t* bitmap) const {
+            return batch(count, bitmap, [bufs](size_t i) { return bufs[i]->getData(); });
+        }
+
+    private:
+        /// @brief Location of a field of at most 64 bits in the word array.
+        struct FieldRef {
+            size_t word;
+            unsigned shift;
+            unsigned width;
+            uint64_t mask;
+        };
+
+        struct RangePredicate {
+            FieldRef f;
+            uint64_t lo;
+            uint64_t hi;
+        };
+
+        struct SetPredicate {
+            FieldRef f;
+            std::vector<uint64_t> values;
+        };
+
+        static FieldRef field(BitRange range) {
+            uint64_t start = range.getStart().getBitIndex();
+            uint64_t end = range.getEnd().getBitIndex() + 1;
+            if (end <= start || end - start > 64) {
+                throw std::invalid_argument("PacketFilter: field must be 1..64 bits wide");
+            }
+            if (end > static_cast<uint64_t>(Bytes) * bitPerByte) {
+                throw std::out_of_range("PacketFilter: field exceeds the buffer");
+            }
+            unsigned width = static_cast<unsigned>(end - start);
+            return FieldRef{static_cast<size_t>(start / 64), static_cast<unsigned>(start % 64), width, detail::bitMaskTables().lowMask[width]};
+        }
+
+        void addWord(size_t i, uint64_t m, uint64_t v) {
+            if (((value[i] ^ v) & mask[i] & m) != 0) {
+                never = true;
+            }
+            mask[i] |= m;
+            value[i] = (value[i] & ~m) | v;
+            if (first > last) {
+                first = last = i;
+            } else {
+                first = std::min(first, i);
+                last = std::max(last, i);
+            }
+        }
+
+        /// @brief Load buffer word `i` little-endian, zero-padding the last word.
+        static uint64_t load(const uint8_t* p, size_t i) {
+            size_t n = Bytes - i * 8 < 8 ? Bytes - i * 8 : 8;
+            return detail::loadLePartial(p + i * 8, n);
+        }
+
+        bool equalWords(const uint8_t* p) const {
+            size_t i = first;
+#if defined(__AVX2__)
+            __m256i diff = _mm256_setzero_si256();
+            for (; i + 4 <= last + 1 && (i + 4) * 8 <= Bytes; i += 4) {
+                __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * 8));
+                __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask.data() + i));
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(value.data() + i));
+                diff = _mm256_or_si256(diff, _mm256_xor_si256(_mm256_and_si256(w, m), v));
+            }
+            if (!_mm256_testz_si256(diff, diff)) {
+                return false;
+            }
+#endif
+            uint64_t d = 0;
+            for (; i <= last && i < words; i++) {
+                d |= (load(p, i) & mask[i]) ^ value[i];
+            }
+            return d == 0;
+        }
+
+        static uint64_t extract(const uint8_t* p, const FieldRef& f) {
+            return detail::readField(p, Bytes, static_cast<uint64_t>(f.word) * 64 + f.shift, f.width);
+        }
+
+        bool extraPredicates(const uint8_t* p) const {
+            for (const RangePredicate& r : ranges) {
+                uint64_t v = extract(p, r.f);
+                if (v < r.lo || v > r.hi) {
+                    return false;
+                }
+            }
+            for (const SetPredicate& s : sets) {
+                if (!std::binary_search(s.values.begin(), s.values.end(), extract(p, s.f))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename Data>
+        size_t batch(size_t count, uint64_t* bitmap, Data data) const {
+            size_t hits = 0;
+            for (size_t base = 0; base < count; base += 64) {
+                size_t n = count - base < 64 ? count - base : 64;
+                uint64_t bits = 0;
+                if (!never) {
+                    for (size_t j = 0; j < n; j++) {
+                        if (j + 1 < n) {
+                            __builtin_prefetch(data(base + j + 1) + first * 8);
+                        }
+                        const uint8_t* p = data(base + j);
+                        bits |= static_cast<uint64_t>(equalWords(p) && extraPredicates(p)) << j;
+                    }
+                }
+                bitmap[base / 64] = bits;
+                hits += static_cast<size_t>(__builtin_popcountll(bits));
+            }
+            return hits;
+        }
+
+        std::vector<uint64_t> mask;
+        std::vector<uint64_t> value;
+        size_t first = 1;       // first and last word with equality bits; first > last if none
+        size_t last = 0;
+        bool never = false;     // two equality predicates contradict each other or a value does not fit
+        std::vector<RangePredicate> ranges;
+        std::vector<SetPredicate> sets;
+};
+
+}
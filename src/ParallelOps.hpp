@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "BitPosition.h"
+#include "ByteBufferView.hpp"
+#include "ThreadPool.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief Default size in bytes below which bulk operations run on the calling thread only.
+constexpr size_t defaultParallelThreshold = 1024 * 1024;
+
+/// @brief Bitwise operation applied by `combine` and `parallelCombine`.
+enum class BitwiseOp {
+    And,    ///< dst = dst & src
+    Or,     ///< dst = dst | src
+    Xor,    ///< dst = dst ^ src
+    AndNot  ///< dst = dst & ~src
+};
+
+namespace detail {
+
+/// @brief Split `size` bytes starting at `addr` into chunks whose inner boundaries are cache-line aligned.
+/// @details Chunk 0 additionally covers the unaligned head, so every later chunk starts on a
+/// cache line and no two chunks share one.
+class Chunking {
+    public:
+        Chunking(const void* addr, size_t size, size_t concurrency) : size(size) {
+            size_t misalign = reinterpret_cast<uintptr_t>(addr) % cacheLineSize;
+            head = misalign == 0 ? 0 : cacheLineSize - misalign;
+            size_t target = size / (concurrency * 4);
+            chunk = std::max(cacheLineSize, (target + cacheLineSize - 1) / cacheLineSize * cacheLineSize);
+            count = size <= head + chunk ? 1 : 1 + (size - head - chunk + chunk - 1) / chunk;
+        }
+        size_t chunks() const { return count; }
+        size_t begin(size_t idx) const { return idx == 0 ? 0 : std::min(size, head + idx * chunk); }
+        size_t end(size_t idx) const { return std::min(size, head + (idx + 1) * chunk); }
+    private:
+        size_t size;
+        size_t head;
+        size_t chunk;
+        size_t count;
+};
+
+inline uint64_t apply(BitwiseOp op, uint64_t a, uint64_t b) {
+    switch (op) {
+        case BitwiseOp::And: return a & b;
+        case BitwiseOp::Or: return a | b;
+        case BitwiseOp::Xor: return a ^ b;
+        case BitwiseOp::AndNot: return a & ~b;
+    }
+    return a;
+}
+
+}
+
+/// @brief Count the set bits in `v`.
+inline uint64_t popcount(ConstByteBufferView v) {
+    const uint8_t* p = v.data();
+    size_t n = v.size();
+    uint64_t cnt = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        cnt += static_cast<uint64_t>(__builtin_popcountll(detail::loadLe64(p + i)));
+    }
+    for (; i < n; i++) {
+        cnt += static_cast<uint64_t>(__builtin_popcount(p[i]));
+    }
+    return cnt;
+}
+
+/// @brief Combine `src` into `dst` byte by byte using `op`; only the common length is processed.
+inline void combine(ByteBufferView dst, ConstByteBufferView src, BitwiseOp op) {
+    uint8_t* d = dst.data();
+    const uint8_t* s = src.data();
+    size_t n = std::min(dst.size(), src.size());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        detail::storeLe64(d + i, detail::apply(op, detail::loadLe64(d + i), detail::loadLe64(s + i)));
+    }
+    for (; i < n; i++) {
+        d[i] = static_cast<uint8_t>(detail::apply(op, d[i], s[i]));
+    }
+}
+
+/// @brief Return the position of the first set bit in `v`, or `bitPositionMax` if none is set.
+inline BitPosition findFirstSet(ConstByteBufferView v) {
+    const uint8_t* p = v.data();
+    size_t n = v.size();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w = detail::loadLe64(p + i);
+        if (w != 0) {
+            // little-endian load: the lowest set bit belongs to the lowest byte
+            uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(w));
+            return BitPosition(static_cast<uint32_t>(i + bit / bitPerByte), static_cast<uint8_t>(bit % bitPerByte));
+        }
+    }
+    for (; i < n; i++) {
+        if (p[i] != 0) {
+            return BitPosition(static_cast<uint32_t>(i), static_cast<uint8_t>(__builtin_ctz(p[i])));
+        }
+    }
+    return bitPositionMax;
+}
+
+/// @brief Return the position of the first byte equal to `value` in `v`, or `bitPositionMax` if none.
+inline BitPosition findByte(ConstByteBufferView v, uint8_t value) {
+    const void* hit = std::memchr(v.data(), value, v.size());
+    if (hit == nullptr) {
+        return bitPositionMax;
+    }
+    return BitPosition(static_cast<uint32_t>(static_cast<const uint8_t*>(hit) - v.data()), 0);
+}
+
+/// @brief Fill every byte of `v` with `val`, splitting large views over `pool`.
+/// @param threshold Views smaller than this many bytes are filled on the calling thread.
+inline void parallelFill(ThreadPool& pool, ByteBufferView v, uint8_t val, size_t threshold = defaultParallelThreshold) {
+    if (v.size() < threshold || pool.concurrency() == 1) {
+        std::memset(v.data(), val, v.size());
+        return;
+    }
+    detail::Chunking c(v.data(), v.size(), pool.concurrency());
+    pool.parallelFor(c.chunks(), [&](size_t idx) {
+        std::memset(v.data() + c.begin(idx), val, c.end(idx) - c.begin(idx));
+    });
+}
+
+/// @brief Count the set bits in `v`, splitting large views over `pool`.
+/// @param threshold Views smaller than this many bytes are counted on the calling thread.
+inline uint64_t parallelPopcount(ThreadPool& pool, ConstByteBufferView v, size_t threshold = defaultParallelThreshold) {
+    if (v.size() < threshold || pool.concurrency() == 1) {
+        return popcount(v);
+    }
+    detail::Chunking c(v.data(), v.size(), pool.concurrency());
+    std::vector<uint64_t> partial(c.chunks());
+    pool.parallelFor(c.chunks(), [&](size_t idx) {
+        partial[idx] = popcount(v.subView(c.begin(idx), c.end(idx) - c.begin(idx)));
+    });
+    uint64_t cnt = 0;
+    for (uint64_t p : partial) {
+        cnt += p;
+    }
+    return cnt;
+}
+
+/// @brief Combine `src` into `dst` using `op`, splitting large views over `pool`.
+/// @param threshold Views smaller than this many bytes are combined on the calling thread.
+inline void parallelCombine(ThreadPool& pool, ByteBufferView dst, ConstByteBufferView src, BitwiseOp op, size_t threshold = defaultParallelThreshold) {
+    size_t n = std::min(dst.size(), src.size());
+    if (n < threshold || pool.concurrency() == 1) {
+        combine(dst, src, op);
+        return;
+    }
+    detail::Chunking c(dst.data(), n, pool.concurrency());
+    pool.parallelFor(c.chunks(), [&](size_t idx) {
+        size_t b = c.begin(idx);
+        size_t len = c.end(idx) - b;
+        combine(dst.subView(b, len), src.subView(b, len), op);
+    });
+}
+
+namespace detail {
+
+/// @brief Run `find` on every chunk and return the earliest hit; chunks behind a known hit are skipped.
+template <typename F>
+BitPosition parallelFindFirst(ThreadPool& pool, ConstByteBufferView v, F find) {
+    Chunking c(v.data(), v.size(), pool.concurrency());
+    std::atomic<size_t> firstChunk{c.chunks()};
+    std::vector<BitPosition> hits(c.chunks(), bitPositionMax);
+    pool.parallelFor(c.chunks(), [&](size_t idx) {
+        if (idx > firstChunk.load(std::memory_order_relaxed)) {
+            return;
+        }
+        size_t b = c.begin(idx);
+        BitPosition hit = find(v.subView(b, c.end(idx) - b));
+        if (hit == bitPositionMax) {
+            return;
+        }
+        hits[idx] = BitPosition(static_cast<uint32_t>(b + hit.getBytePos()), hit.getBitPos());
+        size_t cur = firstChunk.load(std::memory_order_relaxed);
+        while (idx < cur && !firstChunk.compare_exchange_weak(cur, idx, std::memory_order_relaxed)) {
+        }
+    });
+    size_t first = firstChunk.load(std::memory_order_relaxed);
+    return first == c.chunks() ? bitPositionMax : hits[first];
+}
+
+}
+
+/// @brief Return the position of the first set bit in `v`, splitting large views over `pool`.
+/// @return Position of the first set bit, or `bitPositionMax` if none is set.
+inline BitPosition parallelFindFirstSet(ThreadPool& pool, ConstByteBufferView v, size_t threshold = defaultParallelThreshold) {
+    if (v.size() < threshold || pool.concurrency() == 1) {
+        return findFirstSet(v);
+    }
+    return detail::parallelFindFirst(pool, v, [](ConstByteBufferView part) { return findFirstSet(part); });
+}
+
+/// @brief Return the position of the first byte equal to `value`, splitting large views over `pool`.
+/// @return Position of the first matching byte, or `bitPositionMax` if none matches.
+inline BitPosition parallelFindByte(ThreadPool& pool, ConstByteBufferView v, uint8_t value, size_t threshold = defaultParallelThreshold) {
+    if (v.size() < threshold || pool.concurrency() == 1) {
+        return findByte(v, value);
+    }
+    return detail::parallelFindFirst(pool, v, [value](ConstByteBufferView part) { return findByte(part, value); });
+}
+
+}
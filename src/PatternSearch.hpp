@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "BitPosition.h"
+#include "ByteBufferView.hpp"
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+/// @brief Return the 64 bits starting at bit `phase` of the window `lo` followed by the byte `hi`.
+inline uint64_t phaseWindow(uint64_t lo, uint64_t hi, unsigned phase) {
+    return phase == 0 ? lo : (lo >> phase) | (hi << (64 - phase));
+}
+
+/// @brief Matches the 8 bit phases of one byte against an exact pattern.
+class ExactPhases {
+    public:
+        ExactPhases(uint64_t pattern, uint8_t nbits) : mask(bitMaskTables().lowMask[nbits < 64 ? nbits : 64]), pattern(pattern & mask) {
+#if defined(__AVX2__)
+            vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+            vpattern = _mm256_set1_epi64x(static_cast<long long>(this->pattern));
+#endif
+        }
+
+        /// @brief Return a bit mask of the phases 0..7 at which the pattern starts.
+        unsigned operator()(uint64_t lo, uint64_t hi) const {
+#if defined(__AVX2__)
+            __m256i vlo = _mm256_set1_epi64x(static_cast<long long>(lo));
+            __m256i vhi = _mm256_set1_epi64x(static_cast<long long>(hi));
+            __m256i a = _mm256_or_si256(_mm256_srlv_epi64(vlo, _mm256_setr_epi64x(0, 1, 2, 3)),
+                                        _mm256_sllv_epi64(vhi, _mm256_setr_epi64x(64, 63, 62, 61)));
+            __m256i b = _mm256_or_si256(_mm256_srlv_epi64(vlo, _mm256_setr_epi64x(4, 5, 6, 7)),
+                                        _mm256_sllv_epi64(vhi, _mm256_setr_epi64x(60, 59, 58, 57)));
+            a = _mm256_cmpeq_epi64(_mm256_and_si256(a, vmask), vpattern);
+            b = _mm256_cmpeq_epi64(_mm256_and_si256(b, vmask), vpattern);
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(a)) | (_mm256_movemask_pd(_mm256_castsi256_pd(b)) << 4));
+#else
+            unsigned m = 0;
+            for (unsigned ph = 0; ph < bitPerByte; ph++) {
+                if ((phaseWindow(lo, hi, ph) & mask) == pattern) {
+                    m |= 1u << ph;
+                }
+            }
+            return m;
+#endif
+        }
+
+    private:
+        uint64_t mask;
+        uint64_t pattern;
+#if defined(__AVX2__)
+        __m256i vmask;
+        __m256i vpattern;
+#endif
+};
+
+/// @brief Matches the 8 bit phases of one byte against a pattern allowing up to `k` differing bits.
+class TolerantPhases {
+    public:
+        TolerantPhases(uint64_t pattern, uint8_t nbits, uint8_t k) : mask(bitMaskTables().lowMask[nbits < 64 ? nbits : 64]), pattern(pattern & mask), k(k) {
+#if defined(__AVX2__)
+            vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+            vpattern = _mm256_set1_epi64x(static_cast<long long>(this->pattern));
+            vlimit = _mm256_set1_epi64x(static_cast<long long>(k) + 1);
+#endif
+        }
+
+        /// @brief Return a bit mask of the phases 0..7 at which the pattern starts with at most `k` mismatches.
+        unsigned operator()(uint64_t lo, uint64_t hi) const {
+#if defined(__AVX2__)
+            __m256i vlo = _mm256_set1_epi64x(static_cast<long long>(lo));
+            __m256i vhi = _mm256_set1_epi64x(static_cast<long long>(hi));
+            __m256i a = _mm256_or_si256(_mm256_srlv_epi64(vlo, _mm256_setr_epi64x(0, 1, 2, 3)),
+                                        _mm256_sllv_epi64(vhi, _mm256_setr_epi64x(64, 63, 62, 61)));
+            __m256i b = _mm256_or_si256(_mm256_srlv_epi64(vlo, _mm256_setr_epi64x(4, 5, 6, 7)),
+                                        _mm256_sllv_epi64(vhi, _mm256_setr_epi64x(60, 59, 58, 57)));
+            a = _mm256_cmpgt_epi64(vlimit, popcount64(_mm256_and_si256(_mm256_xor_si256(a, vpattern), vmask)));
+            b = _mm256_cmpgt_epi64(vlimit, popcount64(_mm256_and_si256(_mm256_xor_si256(b, vpattern), vmask)));
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(a)) | (_mm256_movemask_pd(_mm256_castsi256_pd(b)) << 4));
+#else
+            unsigned m = 0;
+            for (unsigned ph = 0; ph < bitPerByte; ph++) {
+                if (__builtin_popcountll((phaseWindow(lo, hi, ph) ^ pattern) & mask) <= k) {
+                    m |= 1u << ph;
+                }
+            }
+            return m;
+#endif
+        }
+
+    private:
+#if defined(__AVX2__)
+        /// @brief Population count of each 64-bit lane (nibble lookup plus horizontal byte sum).
+        static __m256i popcount64(__m256i x) {
+            const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low = _mm256_set1_epi8(0x0f);
+            __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(x, low)),
+                                          _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi64(x, 4), low)));
+            return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+        }
+#endif
+
+        uint64_t mask;
+        uint64_t pattern;
+        int k;
+#if defined(__AVX2__)
+        __m256i vmask;
+        __m256i vpattern;
+        __m256i vlimit;
+#endif
+};
+
+/// @brief Return the first position >= `startPos` where `phases` reports a match of an `nbits` wide pattern.
+template <typename Phases>
+BitPosition scanPhases(ConstByteBufferView v, uint8_t nbits, BitPosition startPos, const Phases& phases) {
+    const uint8_t* p = v.data();
+    size_t n = v.size();
+    uint64_t totalBits = static_cast<uint64_t>(n) * bitPerByte;
+    uint64_t startBit = startPos.getBitIndex();
+    if (nbits == 0 || nbits > 64 || startBit + nbits > totalBits) {
+        return bitPositionMax;
+    }
+    uint64_t lastBit = totalBits - nbits;
+    size_t b = startPos.getBytePos();
+    size_t lastByte = static_cast<size_t>(lastBit / bitPerByte);
+    unsigned first = ~((1u << startPos.getBitPos()) - 1) & 0xff;
+
+    // bulk: the window bytes b..b+8 lie inside the view
+    for (; b + 9 <= n && b <= lastByte; b++) {
+        uint64_t lo = loadLe64(p + b);
+        unsigned m = phases(lo, p[b + 8]) & first;
+        first = 0xff;
+        if (b == lastByte) {
+            m &= (2u << (lastBit % bitPerByte)) - 1;
+        }
+        if (m != 0) {
+            return BitPosition(static_cast<uint32_t>(b), static_cast<uint8_t>(__builtin_ctz(m)));
+        }
+    }
+    // tail: zero-padded window
+    for (; b <= lastByte; b++) {
+        uint8_t tmp[9] = {0};
+        std::memcpy(tmp, p + b, n - b < sizeof(tmp) ? n - b : sizeof(tmp));
+        uint64_t lo = loadLe64(tmp);
+        unsigned m = phases(lo, tmp[8]) & first;
+        first = 0xff;
+        if (b == lastByte) {
+            m &= (2u << (lastBit % bitPerByte)) - 1;
+        }
+        if (m != 0) {
+            return BitPosition(static_cast<uint32_t>(b), static_cast<uint8_t>(__builtin_ctz(m)));
+        }
+    }
+    return bitPositionMax;
+}
+
+}
+
+/// @brief Find the first occurrence of an `nbits` wide bit pattern at any bit offset.
+/// @details A match at position `pos` means `get<uint64_t>(pos, nbits) == pattern`, i.e. the LSB of
+/// `pattern` is the bit at `pos`. All 8 bit phases of a byte are tested at once (with AVX2 when
+/// available), so the scan advances one byte per step.
+/// @param v Buffer to search.
+/// @param pattern Pattern in its low `nbits` bits.
+/// @param nbits Pattern width (1..64).
+/// @param startPos First position a match may start at.
+/// @return Start position of the first match, or `bitPositionMax` if there is none.
+inline BitPosition findPattern(ConstByteBufferView v, uint64_t pattern, uint8_t nbits, BitPosition startPos = bitPositionZero) {
+    return detail::scanPhases(v, nbits, startPos, detail::ExactPhases(pattern, nbits));
+}
+
+/// @brief Find the first occurrence of an `nbits` wide bit pattern allowing up to `maxMismatches` differing bits.
+/// @details Same conventions as `findPattern`.
+/// @return Start position of the first match, or `bitPositionMax` if there is none.
+inline BitPosition findPatternTolerant(ConstByteBufferView v, uint64_t pattern, uint8_t nbits, uint8_t maxMismatches, BitPosition startPos = bitPositionZero) {
+    return detail::scanPhases(v, nbits, startPos, detail::TolerantPhases(pattern, nbits, maxMismatches));
+}
+
+}
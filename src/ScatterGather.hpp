@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "ByteBufferView.hpp"
+
+/// @file
+/// @brief Scatter/gather I/O of buffers and views on POSIX file descriptors.
+/// @details A message made of several buffers (e.g. header, options and payload) is written with
+/// `writev`/`sendmsg` directly from the buffers, without first copying them into one contiguous
+/// buffer, and incoming data is read in place into a sequence of buffers. Up to `ioBatchParts`
+/// parts go into one system call; a transfer takes more calls only if it has more parts or the
+/// descriptor accepts fewer bytes at once (e.g. a full pipe). The functions are meant for blocking
+/// descriptors; calls interrupted by a signal are restarted. Like a short `write`, a transfer that
+/// fails after some bytes were moved returns that byte count with `errno` set by the failing call,
+/// so the caller can resume or resynchronise; -1 is only returned if nothing was transferred.
+
+namespace ByteBuffer  {
+
+/// @brief Maximum number of parts passed to a single system call (well below `IOV_MAX`).
+constexpr size_t ioBatchParts = 64;
+
+/// @brief Return the `iovec` describing the bytes of `v`, e.g. for a caller-built `msghdr`.
+inline iovec toIovec(ConstByteBufferView v) {
+    iovec vec;
+    // iovec has no const variant; write-side system calls do not modify the bytes
+    vec.iov_base = const_cast<uint8_t*>(v.data());
+    vec.iov_len = v.size();
+    return vec;
+}
+
+namespace detail {
+
+/// @brief Transfer all bytes of `parts` with `call(iovec*, int count)`, resuming after short transfers.
+/// @return Bytes transferred; less than requested if `call` returned 0 (end of file) or failed after
+/// earlier calls moved bytes (`errno` set). -1 if the first transfer failed.
+template <typename View, typename Call>
+ssize_t transferVectored(const View* parts, size_t count, Call call) {
+    iovec vec[ioBatchParts];
+    size_t next = 0;
+    size_t offset = 0;
+    size_t total = 0;
+    for (;;) {
+        // skip finished and empty parts
+        while (next < count && offset >= parts[next].size()) {
+            offset -= parts[next].size();
+            next++;
+        }
+        if (next == count) {
+            return static_cast<ssize_t>(total);
+        }
+        size_t n = 0;
+        for (size_t i = next; i < count && n < ioBatchParts; i++) {
+            size_t skip = i == next ? offset : 0;
+            vec[n] = toIovec(ConstByteBufferView(parts[i].data() + skip, parts[i].size() - skip));
+            n++;
+        }
+        ssize_t r = call(vec, static_cast<int>(n));
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return total != 0 ? static_cast<ssize_t>(total) : -1;
+        }
+        if (r == 0) {
+            return static_cast<ssize_t>(total);
+        }
+        offset += static_cast<size_t>(r);
+        total += static_cast<size_t>(r);
+    }
+}
+
+}
+
+/// @brief Write all bytes of `parts`, in order, to `fd` with `writev`.
+/// @return Number of bytes written: the sum of the part sizes, fewer if an error (`errno` set)
+/// stopped the transfer after some bytes, or -1 if nothing was written.
+inline ssize_t writeVectored(int fd, const ConstByteBufferView* parts, size_t count) {
+    return detail::transferVectored(parts, count, [fd](iovec* vec, int n) {
+        return ::writev(fd, vec, n);
+    });
+}
+
+/// @brief Write all bytes of `parts`, in order, to `fd` with `writev`.
+inline ssize_t writeVectored(int fd, std::initializer_list<ConstByteBufferView> parts) {
+    return writeVectored(fd, parts.begin(), parts.size());
+}
+
+/// @brief Send all bytes of `parts`, in order, on the connected socket `fd` with `sendmsg`.
+/// @param flags Passed to `sendmsg`, e.g. `MSG_NOSIGNAL` to get `EPIPE` instead of `SIGPIPE`.
+/// @return Number of bytes sent; fewer than the sum of the part sizes if an error (`errno` set)
+/// stopped the transfer, or -1 if nothing was sent.
+inline ssize_t sendVectored(int fd, const ConstByteBufferView* parts, size_t count, int flags = 0) {
+    return detail::transferVectored(parts, count, [fd, flags](iovec* vec, int n) {
+        msghdr msg = {};
+        msg.msg_iov = vec;
+        msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(n);
+        return ::sendmsg(fd, &msg, flags);
+    });
+}
+
+/// @brief Send all bytes of `parts`, in order, on the connected socket `fd` with `sendmsg`.
+inline ssize_t sendVectored(int fd, std::initializer_list<ConstByteBufferView> parts, int flags = 0) {
+    return sendVectored(fd, parts.begin(), parts.size(), flags);
+}
+
+/// @brief Fill `parts`, in order, with bytes read from `fd` with `readv`.
+/// @return Number of bytes read; less than the sum of the part sizes at end of file or if an error
+/// (`errno` set) stopped the transfer after some bytes. -1 if the first read failed.
+inline ssize_t readVectored(int fd, const ByteBufferView* parts, size_t count) {
+    return detail::transferVectored(parts, count, [fd](iovec* vec, int n) {
+        return ::readv(fd, vec, n);
+    });
+}
+
+/// @brief Fill `parts`, in order, with bytes read from `fd` with `readv`.
+inline ssize_t readVectored(int fd, std::initializer_list<ByteBufferView> parts) {
+    return readVectored(fd, parts.begin(), parts.size());
+}
+
+/// @brief Fill `buf` with bytes read from `fd`.
+/// @return Number of bytes read; less than `buf.size()` at end of file or after an error
+/// (`errno` set) that followed some bytes. -1 if the first read failed.
+inline ssize_t readInto(int fd, ByteBufferView buf) {
+    return readVectored(fd, &buf, 1);
+}
+
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ByteBuffer.hpp"
+
+namespace ByteBuffer  {
+
+/// @brief `ByteBuffer` shared between one writer and any number of lock-free readers (seqlock).
+/// @details The writer modifies a private copy of the buffer and publishes the changed 64-bit words
+/// into the shared storage between two increments of a sequence counter, which is odd while a
+/// publication is in progress. Readers copy the words they need and retry if the counter was odd or
+/// changed meanwhile, so field reads and snapshots are never torn. Readers only load shared memory
+/// and never block the writer; they may retry while the writer publishes. Batch several field writes
+/// into one `update` to publish them together.
+/// @note There must be a single writer at a time; concurrent writers must be serialized externally.
+/// @tparam Bytes Number of bytes stored in the buffer.
+template <size_t Bytes>
+class SeqLockedByteBuffer {
+        static_assert(Bytes != 0, "buffer must not be empty");
+
+        static constexpr size_t words = (Bytes + 7) / 8;
+
+    public:
+        /// @brief Construct a zero-initialized buffer.
+        SeqLockedByteBuffer() {
+            for (size_t i = 0; i < words; i++) {
+                shared[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Construct a buffer holding the contents of `initial`.
+        explicit SeqLockedByteBuffer(const ByteBuffer<Bytes>& initial) : shadow(initial) {
+            for (size_t i = 0; i < words; i++) {
+                shared[i].store(shadowWord(i), std::memory_order_relaxed);
+            }
+        }
+
+        SeqLockedByteBuffer(const SeqLockedByteBuffer&) = delete;
+        SeqLockedByteBuffer& operator=(const SeqLockedByteBuffer&) = delete;
+
+        /// @brief Return the number of bytes in the buffer.
+        constexpr size_t size() const { return Bytes; }
+
+        /// @brief Writer: apply `fn` to the writer's copy and publish the result as one update.
+        /// @details `fn` is called as `fn(ByteBuffer<Bytes>&)` and may use the whole `ByteBuffer` API;
+        /// readers see either none or all of its changes.
+        template <typename F>
+        void update(F&& fn) {
+            fn(shadow);
+            publish(0, words - 1);
+        }
+
+        /// @brief Writer: write `value` into `range` as in `ByteBuffer::set` and publish it.
+        template <typename N>
+        void set(const BitRange range, N value) {
+            shadow.set(range, value);
+            uint64_t start = range.getStart().getBitIndex();
+            uint64_t end = range.getEnd().getBitIndex() + 1;
+            publishBits(start, end);
+        }
+
+        /// @brief Writer: write the low `bitCount` bits of `value` at `pos` as in `ByteBuffer::set` and publish them.
+        template <typename N>
+        void set(const BitPosition pos, N value, const uint8_t bitCount) {
+            shadow.set(pos, value, bitCount);
+            uint64_t start = pos.getBitIndex();
+            publishBits(start, start + bitCount);
+        }
+
+        /// @brief Writer: return the writer's copy, i.e. the last published contents.
+        const ByteBuffer<Bytes>& writerView() const { return shadow; }
+
+        /// @brief Return the sequence number of the last completed update (even; 0 before the first).
+        /// @details Readers can compare it with an earlier value to detect changes cheaply.
+        uint64_t sequence() const {
+            uint64_t s = seq.load(std::memory_order_acquire);
+            return s & ~static_cast<uint64_t>(1);
+        }
+
+        /// @brief Reader: return a consistent copy of the whole buffer.
+        ByteBuffer<Bytes> snapshot() const {
+            ByteBuffer<Bytes> out(noInit);
+            read(0, words - 1, [&out](size_t i, uint64_t w) {
+                detail::storeLePartial(out.data() + i * 8, w, wordBytes(i));
+            });
+            return out;
+        }
+
+        /// @brief Reader: return the bits of `range` in the lower bits of the result, as `ByteBuffer::get`.
+        /// @throws std::out_of_range if the range does not lie inside the buffer.
+        /// @throws std::invalid_argument if the range is wider than 64 bits.
+        template <typename N>
+        N get(const BitRange range) const {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            uint64_t start = range.getStart().getBitIndex();
+            uint64_t end = range.getEnd().getBitIndex() + 1;
+            if (end > static_cast<uint64_t>(Bytes) * bitPerByte) {
+                throw std::out_of_range("SeqLockedByteBuffer: range exceeds the buffer");
+            }
+            if (end <= start || end - start > 64) {
+                throw std::invalid_argument("SeqLockedByteBuffer: range must be 1..64 bits wide");
+            }
+            return static_cast<N>(extract(start, static_cast<unsigned>(end - start)));
+        }
+
+        /// @brief Reader: return up to `bitCount` bits starting at `pos`, as `ByteBuffer::get`.
+        /// @details Bits beyond the end of the buffer or the width of `N` are dropped.
+        template <typename N>
+        N get(const BitPosition pos, const uint8_t bitCount) const {
+            static_assert(std::is_integral<N>::value,"only integral types are allowed");
+            uint64_t start = pos.getBitIndex();
+            uint64_t end = start + std::min<uint64_t>(bitCount, sizeof(N) * bitPerByte);
+            if (end > static_cast<uint64_t>(Bytes) * bitPerByte) {
+                end = static_cast<uint64_t>(Bytes) * bitPerByte;
+            }
+            if (end <= start) {
+                return 0;
+            }
+            return static_cast<N>(extract(start, static_cast<unsigned>(end - start)));
+        }
+
+        /// @brief Reader: return whether the bit at `pos` is set.
+        /// @throws std::out_of_range if `pos` lies outside the buffer.
+        bool isSet(const BitPosition pos) const {
+            return get<uint8_t>(BitRange(pos, pos)) != 0;
+        }
+
+        /// @brief Reader: return whether the bits of `range` equal `v`, like `Bits::hasValue`.
+        /// @throws Like `get`.
+        bool hasValue(const BitRange range, uint32_t v) const {
+            return get<uint32_t>(range) == v;
+        }
+
+    private:
+        /// @brief Number of buffer bytes in word `i`.
+        static constexpr size_t wordBytes(size_t i) {
+            return i + 1 < words || Bytes % 8 == 0 ? 8 : Bytes % 8;
+        }
+
+        /// @brief Load word `i` of the writer's copy little-endian, zero-padding the last word.
+        uint64_t shadowWord(size_t i) const {
+            return detail::loadLePartial(shadow.getData() + i * 8, wordBytes(i));
+        }
+
+        /// @brief Publish the words holding bits `[start, end)`, clamped to the buffer.
+        void publishBits(uint64_t start, uint64_t end) {
+            uint64_t maxBit = static_cast<uint64_t>(Bytes) * bitPerByte;
+            end = end < maxBit ? end : maxBit;
+            if (end > start) {
+                publish(static_cast<size_t>(start / 64), static_cast<size_t>((end - 1) / 64));
+            }
+        }
+
+        /// @brief Copy words `first..last` of the writer's copy into the shared words.
+        void publish(size_t first, size_t last) {
+            uint64_t s = seq.load(std::memory_order_relaxed);
+            seq.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = first; i <= last; i++) {
+                shared[i].store(shadowWord(i), std::memory_order_relaxed);
+            }
+            seq.store(s + 2, std::memory_order_release);
+        }
+
+        /// @brief Pass a consistent copy of the shared words `first..last` to `sink(i, word)`, retrying on conflicts.
+        /// @details `sink` may be called again for the same words by a retry.
+        template <typename Sink>
+        void read(size_t first, size_t last, Sink sink) const {
+            for (unsigned spins = 0;; spins++) {
+                uint64_t s = seq.load(std::memory_order_acquire);
+                if ((s & 1) == 0) {
+                    for (size_t i = first; i <= last; i++) {
+                        sink(i, shared[i].load(std::memory_order_relaxed));
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (seq.load(std::memory_order_relaxed) == s) {
+                        return;
+                    }
+                }
+                backoff(spins);
+            }
+        }
+
+        /// @brief Return the `width` bits at absolute bit `start` from one consistent read.
+        uint64_t extract(uint64_t start, unsigned width) const {
+            size_t first = static_cast<size_t>(start / 64);
+            size_t last = static_cast<size_t>((start + width - 1) / 64);
+            uint8_t bytes[16] = {};
+            read(first, last, [&bytes, first](size_t i, uint64_t v) { detail::storeLe64(bytes + (i - first) * 8, v); });
+            return detail::readField(bytes, sizeof(bytes), start % 64, width);
+        }
+
+        /// @brief Wait briefly before retrying a read; yields once the writer seems descheduled.
+        static void backoff(unsigned spins) {
+            if (spins < 64) {
+#if defined(__SSE2__)
+                _mm_pause();
+#endif
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        alignas(cacheLineSize) std::atomic<uint64_t> seq{0};
+        std::atomic<uint64_t> shared[words];
+        ByteBuffer<Bytes> shadow;
+};
+
+}
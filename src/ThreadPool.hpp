@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ByteBuffer  {
+
+/// @brief Fixed-size pool of worker threads executing index-parallel loops.
+/// @details `parallelFor` distributes the task indices `0..count-1` over the workers and the
+/// calling thread, and returns when every task has finished. Only one loop runs at a time;
+/// concurrent callers are serialized.
+class ThreadPool {
+    public:
+        /// @brief Construct a pool with `threads` threads in total, including the caller.
+        /// @param threads Total concurrency; 0 selects `std::thread::hardware_concurrency()`.
+        explicit ThreadPool(size_t threads = 0) {
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            if (threads == 0) {
+                threads = 1;
+            }
+            for (size_t i = 1; i < threads; i++) {
+                workers.emplace_back([this]() { run(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stop = true;
+            }
+            wake.notify_all();
+            for (std::thread& t : workers) {
+                t.join();
+            }
+        }
+
+        /// @brief Return the total concurrency (workers plus the calling thread).
+        size_t concurrency() const { return workers.size() + 1; }
+
+        /// @brief Run `fn(i)` for every `i` in `0..count-1` and wait for completion.
+        /// @param count Number of tasks.
+        /// @param fn Callable invoked once per task index; must be safe to call concurrently.
+        void parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+            if (count == 0) {
+                return;
+            }
+            if (workers.empty() || count == 1) {
+                for (size_t i = 0; i < count; i++) {
+                    fn(i);
+                }
+                return;
+            }
+            std::lock_guard<std::mutex> serial(callMtx);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                task = &fn;
+                taskCount = count;
+                next.store(0, std::memory_order_relaxed);
+                pending = count;
+                generation++;
+            }
+            wake.notify_all();
+            work(&fn, count);
+
+            std::unique_lock<std::mutex> lock(mtx);
+            done.wait(lock, [this]() { return pending == 0 && active == 0; });
+            task = nullptr;
+        }
+
+    private:
+        /// @brief Worker loop: wait for a new loop generation and help executing it.
+        void run() {
+            uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(mtx);
+            for (;;) {
+                wake.wait(lock, [this, seen]() { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+                if (task == nullptr) {
+                    continue;
+                }
+                const std::function<void(size_t)>* fn = task;
+                size_t count = taskCount;
+                active++;
+                lock.unlock();
+                work(fn, count);
+                lock.lock();
+                active--;
+                if (pending == 0 && active == 0) {
+                    done.notify_all();
+                }
+            }
+        }
+
+        /// @brief Claim and execute task indices of the current loop until none are left.
+        void work(const std::function<void(size_t)>* fn, size_t count) {
+            size_t finished = 0;
+            for (;;) {
+                size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= count) {
+                    break;
+                }
+                (*fn)(i);
+                finished++;
+            }
+            if (finished != 0) {
+                std::lock_guard<std::mutex> lock(mtx);
+                pending -= finished;
+                if (pending == 0 && active == 0) {
+                    done.notify_all();
+                }
+            }
+        }
+
+        std::vector<std::thread> workers;
+        std::mutex callMtx;
+        std::mutex mtx;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(size_t)>* task = nullptr;
+        size_t taskCount = 0;
+        std::atomic<size_t> next{0};
+        size_t pending = 0;
+        size_t active = 0;
+        uint64_t generation = 0;
+        bool stop = false;
+};
+
+}
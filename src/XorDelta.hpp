@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "ByteBufferView.hpp"
+#include "DynamicByteBuffer.hpp"
+#include "Endian.hpp"
+
+/// @file
+/// @brief XOR delta codec between successive versions of a buffer.
+/// @details The delta of two equally sized frames is their XOR, split into 64-bit words (the
+/// last one zero-padded) and stored as runs. It starts with the frame size in bytes, followed by
+/// pairs of a count of zero words to skip and a count of literal words, each pair followed by
+/// its literal XOR words (8 bytes, little-endian). Counts are LEB128 varints. Trailing zero words
+/// are not stored, so identical frames give a delta of only the size. Zero regions are skipped
+/// 32 bytes per step with AVX2.
+
+namespace ByteBuffer  {
+
+namespace detail {
+
+inline size_t writeVarint(uint8_t* p, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = static_cast<uint8_t>(v);
+    return n;
+}
+
+/// @brief Read a varint at `p[pos]`, advancing `pos`; false if truncated or longer than 64 bits.
+inline bool readVarint(const uint8_t* p, size_t size, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (pos >= size) {
+            return false;
+        }
+        uint8_t b = p[pos++];
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief XOR of word `i` of two frames of `size` bytes, zero-padding the last word.
+inline uint64_t xorWord(const uint8_t* a, const uint8_t* b, size_t size, size_t i) {
+    size_t n = size - i * 8 < 8 ? size - i * 8 : 8;
+    return loadLePartial(a + i * 8, n) ^ loadLePartial(b + i * 8, n);
+}
+
+/// @brief Return the first word from `i` on where the frames differ, or `words` if none.
+inline size_t nextDifference(const uint8_t* a, const uint8_t* b, size_t size, size_t words, size_t i) {
+#if defined(__AVX2__)
+    for (; (i + 4) * 8 <= size; i += 4) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * 8)),
+                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i * 8)));
+        if (!_mm256_testz_si256(x, x)) {
+            break;
+        }
+    }
+#endif
+    while (i < words && xorWord(a, b, size, i) == 0) {
+        i++;
+    }
+    return i;
+}
+
+}
+
+/// @brief Encode the XOR delta turning `prev` into `next`; see the file description for the format.
+/// @param out Receives the delta; its previous contents are replaced.
+/// @return false if the frames differ in size (`out` is then empty).
+inline bool encodeXorDelta(ConstByteBufferView prev, ConstByteBufferView next, DynamicByteBuffer& out) {
+    out.clear();
+    if (prev.size() != next.size()) {
+        return false;
+    }
+    const uint8_t* a = prev.data();
+    const uint8_t* b = next.data();
+    size_t size = next.size();
+    size_t words = (size + 7) / 8;
+    out.resize(10);
+    size_t used = detail::writeVarint(out.data(), size);
+    size_t i = 0;
+    for (;;) {
+        size_t start = detail::nextDifference(a, b, size, words, i);
+        if (start == words) {
+            break;
+        }
+        size_t end = start + 1;
+        while (end < words && detail::xorWord(a, b, size, end) != 0) {
+            end++;
+        }
+        out.resize(used + 20 + (end - start) * 8);
+        uint8_t* p = out.data();
+        used += detail::writeVarint(p + used, start - i);
+        used += detail::writeVarint(p + used, end - start);
+        for (size_t k = start; k < end; k++, used += 8) {
+            detail::storeLe64(p + used, detail::xorWord(a, b, size, k));
+        }
+        i = end;
+    }
+    out.resize(used);
+    return true;
+}
+
+/// @brief Apply the XOR delta `delta` to `frame`, turning the previous version into the next.
+/// @details The delta is validated before `frame` is modified.
+/// @return false if the delta is malformed or was made for frames of another size.
+inline bool applyXorDelta(ByteBufferView frame, ConstByteBufferView delta) {
+    const uint8_t* d = delta.data();
+    size_t n = delta.size();
+    size_t words = (frame.size() + 7) / 8;
+    for (int pass = 0; pass < 2; pass++) {
+        size_t pos = 0;
+        uint64_t size;
+        if (!detail::readVarint(d, n, pos, size) || size != frame.size()) {
+            return false;
+        }
+        uint64_t i = 0;
+        while (pos < n) {
+            uint64_t skip;
+            uint64_t lit;
+            if (!detail::readVarint(d, n, pos, skip) || !detail::readVarint(d, n, pos, lit)) {
+                return false;
+            }
+            if (skip > words - i || lit > words - i - skip || lit > (n - pos) / 8) {
+                return false;
+            }
+            i += skip;
+            if (pass == 1) {
+                uint8_t* p = frame.data();
+                for (uint64_t k = 0; k < lit; k++) {
+                    size_t w = static_cast<size_t>(i + k);
+                    size_t len = frame.size() - w * 8 < 8 ? frame.size() - w * 8 : 8;
+                    uint64_t x = detail::loadLePartial(p + w * 8, len) ^ detail::loadLe64(d + pos + k * 8);
+                    detail::storeLePartial(p + w * 8, x, len);
+                }
+            }
+            i += lit;
+            pos += static_cast<size_t>(lit) * 8;
+        }
+    }
+    return true;
+}
+
+}
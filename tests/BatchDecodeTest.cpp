@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "BatchDecode.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+/// @brief read `width` bits starting at absolute bit `start`, LSB first
+uint64_t field(const ByteBuffer::ByteBuffer<20> &b, uint32_t start, uint32_t width) {
+  uint64_t v = 0;
+  for (uint32_t i = 0; i < width; i++) {
+    uint32_t bit = start + i;
+    v |= static_cast<uint64_t>((b.getData()[bit / 8] >> (bit % 8)) & 1) << i;
+  }
+  return v;
+}
+
+std::vector<ByteBuffer::ByteBuffer<20>> randomRecords(size_t count) {
+  std::vector<ByteBuffer::ByteBuffer<20>> records(count);
+  uint32_t seed = 21;
+  for (auto &r : records) {
+    for (size_t i = 0; i < r.size(); i++) {
+      r.data()[i] = static_cast<uint8_t>(TestUtil::nextRandom(seed));
+    }
+  }
+  return records;
+}
+
+const std::vector<ByteBuffer::BitRange> fields = {
+  ByteBuffer::BitRange(ByteBuffer::BitPosition(0,3),static_cast<uint16_t>(5)),
+  ByteBuffer::BitRange(ByteBuffer::BitPosition(6,2),static_cast<uint16_t>(40)),
+  ByteBuffer::BitRange(ByteBuffer::BitPosition(12,0),static_cast<uint16_t>(64)),
+};
+
+const uint32_t starts[3] = {3,50,96};
+const uint32_t widths[3] = {5,40,64};
+
+}
+
+/***************************************************************************************************************
+ * Decoding
+ ***************************************************************************************************************/
+
+/// @brief test if every record of a large batch is decoded once into its row of every column
+/// The threshold of 0 forces the parallel path with work stealing
+TEST(BatchDecode, ParallelDecode_ShouldFillEveryRow) {
+  const size_t n = 20000;
+  std::vector<ByteBuffer::ByteBuffer<20>> records = randomRecords(n);
+  ByteBuffer::BatchDecoder<20> decoder(fields);
+  ByteBuffer::ThreadPool pool(4);
+  ByteBuffer::DecodedColumns<uint64_t> out(decoder.fieldCount(),n);
+  decoder.decode(pool,records.data(),n,out.data(),0);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t f = 0; f < 3; f++) {
+      ASSERT_EQ(out.column(f)[i],field(records[i],starts[f],widths[f])) << i << " " << f;
+    }
+  }
+}
+
+/// @brief test if a batch given as pointers decodes like the sequential path
+TEST(BatchDecode, PointerBatch_ShouldMatchSequentialDecode) {
+  const size_t n = 3000;
+  std::vector<ByteBuffer::ByteBuffer<20>> records = randomRecords(n);
+  std::vector<const ByteBuffer::ByteBuffer<20>*> ptrs;
+  for (size_t i = n; i-- > 0;) {
+    ptrs.push_back(&records[i]);
+  }
+  ByteBuffer::BatchDecoder<20> decoder({fields[0],fields[1]});
+  ByteBuffer::ThreadPool pool(3);
+  ByteBuffer::ThreadPool single(1);
+  std::vector<uint64_t> a0(n), a1(n), b0(n), b1(n);
+  uint64_t *a[2] = {a0.data(),a1.data()};
+  uint64_t *b[2] = {b0.data(),b1.data()};
+  decoder.decode(pool,ptrs.data(),n,a,0);
+  decoder.decode(single,ptrs.data(),n,b);
+  EXPECT_EQ(a0,b0);
+  EXPECT_EQ(a1,b1);
+  EXPECT_EQ(a1[0],field(records[n - 1],50,40));
+}
+
+/***************************************************************************************************************
+ * Errors
+ ***************************************************************************************************************/
+
+/// @brief test if fields outside the buffer or wider than the column type are rejected
+TEST(BatchDecode, InvalidFields_ShouldThrow) {
+  EXPECT_THROW(ByteBuffer::BatchDecoder<20>({ByteBuffer::BitRange(ByteBuffer::BitPosition(19,4),static_cast<uint16_t>(8))}),std::out_of_range);
+  EXPECT_THROW(ByteBuffer::BatchDecoder<20>({ByteBuffer::BitRange(ByteBuffer::BitPosition(0,0),static_cast<uint16_t>(65))}),std::invalid_argument);
+  ByteBuffer::BatchDecoder<20> decoder(fields);
+  ByteBuffer::ThreadPool pool(1);
+  std::vector<ByteBuffer::ByteBuffer<20>> records(1);
+  ByteBuffer::DecodedColumns<uint32_t> out(3,1);
+  EXPECT_THROW(decoder.decode(pool,records.data(),1,out.data()),std::invalid_argument);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "BitExpression.hpp"
+#include "ParallelOps.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+/// @brief whether `ByteBuffer::any` accepts an argument of type `T`
+template <typename T, typename = void>
+struct AcceptsAny : std::false_type {};
+
+template <typename T>
+struct AcceptsAny<T, decltype(static_cast<void>(ByteBuffer::any(std::declval<const T&>())))> : std::true_type {};
+
+}
+
+/***************************************************************************************************************
+ * Assignment
+ ***************************************************************************************************************/
+
+/// @brief test if a combined expression equals the bytewise result, including the unaligned tail
+TEST(BitExpression, Assign_ShouldMatchBytewiseResult) {
+  ByteBuffer::ByteBuffer<100> a, b, c, d;
+  TestUtil::fillRandom(a.data(),a.size(),1);
+  TestUtil::fillRandom(b.data(),b.size(),2);
+  TestUtil::fillRandom(c.data(),c.size(),3);
+  TestUtil::fillRandom(d.data(),d.size(),4);
+  ByteBuffer::ByteBuffer<100> r = ((a & b) | ~c) ^ ByteBuffer::andNot(d,a);
+  for (size_t i = 0; i < 100; i++) {
+    uint8_t expected = static_cast<uint8_t>(((a.getData()[i] & b.getData()[i]) | ~c.getData()[i]) ^ (d.getData()[i] & ~a.getData()[i]));
+    ASSERT_EQ(r.getData()[i],expected) << i;
+  }
+}
+
+/// @brief test if a buffer can be assigned an expression of itself
+TEST(BitExpression, AssignToOperand_ShouldUpdateInPlace) {
+  ByteBuffer::ByteBuffer<72> a, b;
+  TestUtil::fillRandom(a.data(),a.size(),5);
+  TestUtil::fillRandom(b.data(),b.size(),6);
+  std::vector<uint8_t> before(a.getData(),a.getData() + a.size());
+  a = a ^ b;
+  a = a ^ b;
+  EXPECT_EQ(std::vector<uint8_t>(a.getData(),a.getData() + a.size()),before);
+}
+
+/// @brief test if operands of different length only produce the common length
+TEST(BitExpression, AssignToView_ShouldWriteCommonLength) {
+  std::vector<uint8_t> x(40,0xf0);
+  std::vector<uint8_t> y(37,0x3c);
+  std::vector<uint8_t> out(50,0x11);
+  ByteBuffer::ConstByteBufferView vx(x.data(),x.size());
+  ByteBuffer::ConstByteBufferView vy(y.data(),y.size());
+  EXPECT_EQ(ByteBuffer::assign(ByteBuffer::ByteBufferView(out.data(),out.size()),vx | vy),37u);
+  for (size_t i = 0; i < out.size(); i++) {
+    EXPECT_EQ(out[i],i < 37 ? 0xfc : 0x11) << i;
+  }
+}
+
+/// @brief test if constructing from a shorter expression zeroes the bytes beyond it
+/// The buffer is built over storage filled with ones so stale bytes would show
+TEST(BitExpression, ConstructFromShorterExpression_ShouldZeroTail) {
+  std::vector<uint8_t> x(5,0xf0);
+  std::vector<uint8_t> y(7,0x3c);
+  ByteBuffer::ConstByteBufferView vx(x.data(),x.size());
+  ByteBuffer::ConstByteBufferView vy(y.data(),y.size());
+  alignas(ByteBuffer::ByteBuffer<16>) unsigned char storage[sizeof(ByteBuffer::ByteBuffer<16>)];
+  std::memset(storage,0xff,sizeof(storage));
+  ByteBuffer::ByteBuffer<16> *r = new (storage) ByteBuffer::ByteBuffer<16>(vx & vy);
+  for (size_t i = 0; i < r->size(); i++) {
+    EXPECT_EQ(r->getData()[i],i < 5 ? 0x30 : 0) << i;
+  }
+}
+
+/***************************************************************************************************************
+ * Reductions
+ ***************************************************************************************************************/
+
+/// @brief test if reductions of an expression equal those of the materialized result
+TEST(BitExpression, Reductions_ShouldMatchMaterializedResult) {
+  ByteBuffer::ByteBuffer<203> a, b;
+  TestUtil::fillRandom(a.data(),a.size(),7);
+  TestUtil::fillRandom(b.data(),b.size(),8);
+  ByteBuffer::ByteBuffer<203> r = a & ~b;
+  EXPECT_EQ(ByteBuffer::popcount(a & ~b),ByteBuffer::popcount(r));
+  EXPECT_TRUE(ByteBuffer::any(a & ~b));
+  EXPECT_TRUE(ByteBuffer::none(a ^ a));
+  EXPECT_FALSE(ByteBuffer::none(a));
+}
+
+/// @brief test if a single set bit past the vector part of the loop is found
+TEST(BitExpression, AnyInTail_ShouldFindLastBit) {
+  ByteBuffer::ByteBuffer<67> a, b;
+  b.data()[66] = 0x80;
+  EXPECT_FALSE(ByteBuffer::any(a & b));
+  EXPECT_TRUE(ByteBuffer::any(a | b));
+  EXPECT_EQ(ByteBuffer::popcount(a | b),1u);
+}
+
+/// @brief test if the reductions only take buffers, views and expressions
+/// Other types are rejected by overload resolution instead of failing inside the function body
+TEST(BitExpression, NonOperand_ShouldNotBeAccepted) {
+  EXPECT_TRUE((AcceptsAny<ByteBuffer::ByteBuffer<4>>::value));
+  EXPECT_TRUE((AcceptsAny<ByteBuffer::ConstByteBufferView>::value));
+  EXPECT_FALSE((AcceptsAny<int>::value));
+  EXPECT_FALSE((AcceptsAny<std::vector<uint8_t>>::value));
+}
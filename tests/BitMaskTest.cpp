@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "DynamicByteBuffer.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+uint64_t random64(uint32_t &seed) {
+  uint64_t hi = TestUtil::nextRandom(seed);
+  return hi << 32 | TestUtil::nextRandom(seed);
+}
+
+/// @brief read `width` bits starting at absolute bit `start`, LSB first
+uint64_t referenceRead(const std::vector<uint8_t> &b, uint64_t start, unsigned width) {
+  uint64_t v = 0;
+  for (unsigned i = 0; i < width; i++) {
+    uint64_t bit = start + i;
+    v |= static_cast<uint64_t>((b[bit / 8] >> (bit % 8)) & 1) << i;
+  }
+  return v;
+}
+
+/// @brief write the low `width` bits of `v` starting at absolute bit `start`, LSB first
+void referenceWrite(std::vector<uint8_t> &b, uint64_t start, uint64_t v, unsigned width) {
+  for (unsigned i = 0; i < width; i++) {
+    uint64_t bit = start + i;
+    uint8_t mask = static_cast<uint8_t>(1u << (bit % 8));
+    b[bit / 8] = static_cast<uint8_t>(((v >> i) & 1) ? b[bit / 8] | mask : b[bit / 8] & ~mask);
+  }
+}
+
+}
+
+/***************************************************************************************************************
+ * Tables
+ ***************************************************************************************************************/
+
+/// @brief test if the compile-time tables describe the bytes a field covers
+TEST(BitMask, Tables_ShouldDescribeFieldBytes) {
+  constexpr ByteBuffer::detail::BitMaskTables t{};
+  static_assert(t.span[3][5] == 1, "field inside one byte");
+  static_assert(t.firstMask[3][5] == 0xf8, "upper five bits of the first byte");
+  EXPECT_EQ(t.span[5][12],3);
+  EXPECT_EQ(t.firstMask[5][12],0xe0);
+  EXPECT_EQ(t.lastMask[5][12],0x01);
+  EXPECT_EQ(t.lastShift[5][12],11);
+  EXPECT_EQ(t.span[7][64],9);
+  EXPECT_EQ(t.lastMask[7][64],0x7f);
+  EXPECT_EQ(t.lastShift[7][64],57);
+  EXPECT_EQ(t.lowMask[64],~0ull);
+  EXPECT_EQ(t.lowMask[9],0x1ffu);
+}
+
+/***************************************************************************************************************
+ * Field access
+ ***************************************************************************************************************/
+
+/// @brief test if fields of every width at every offset match a bit-by-bit reference, near the end too
+TEST(BitMask, ReadWriteField_ShouldMatchBitwiseReference) {
+  uint32_t seed = 5;
+  std::vector<uint8_t> data(24);
+  for (uint8_t &b : data) {
+    b = static_cast<uint8_t>(TestUtil::nextRandom(seed));
+  }
+  std::vector<uint8_t> expected = data;
+  for (unsigned width = 1; width <= 64; width++) {
+    for (uint64_t start = 0; start + width <= data.size() * 8; start += 3) {
+      ASSERT_EQ(ByteBuffer::detail::readField(data.data(),data.size(),start,width),referenceRead(data,start,width));
+      uint64_t v = random64(seed);
+      ByteBuffer::detail::writeField(data.data(),data.size(),start,v,width);
+      referenceWrite(expected,start,v,width);
+      ASSERT_EQ(data,expected) << start << " " << width;
+    }
+  }
+}
+
+/// @brief test if ByteBuffer and DynamicByteBuffer fields keep their truncation and range rules
+TEST(BitMask, BufferAccess_ShouldTruncateAndCheckRanges) {
+  ByteBuffer::ByteBuffer<3> b;
+  b.set(ByteBuffer::BitPosition(1,4),0xabcdu,16);
+  EXPECT_EQ(b.getData()[1],0xd0);
+  EXPECT_EQ(b.getData()[2],0xbc);
+  EXPECT_EQ(b.get<uint32_t>(ByteBuffer::BitPosition(1,4),32),0xbcdu);
+  b.set(ByteBuffer::BitRange(ByteBuffer::BitPosition(0,2),static_cast<uint16_t>(10)),static_cast<int8_t>(-1));
+  EXPECT_EQ(b.get<uint16_t>(ByteBuffer::BitRange(ByteBuffer::BitPosition(0,2),static_cast<uint16_t>(10))),0x3ffu);
+  EXPECT_THROW(b.get<uint32_t>(ByteBuffer::BitRange(ByteBuffer::BitPosition(2,4),static_cast<uint16_t>(5))),std::out_of_range);
+
+  ByteBuffer::DynamicByteBuffer d;
+  d.append(0x1234567u,28);
+  d.append(0x5u,3);
+  EXPECT_EQ(d.get<uint32_t>(ByteBuffer::BitPosition(0,0),28),0x1234567u);
+  EXPECT_EQ(d.get<uint8_t>(ByteBuffer::BitPosition(3,0),8),0x51u);
+  EXPECT_THROW(d.set(ByteBuffer::BitRange(ByteBuffer::BitPosition(3,6),static_cast<uint16_t>(4)),1u),std::out_of_range);
+}
+
+/***************************************************************************************************************
+ * Position arithmetic
+ ***************************************************************************************************************/
+
+/// @brief test if position arithmetic and ordering match absolute bit indices
+TEST(BitMask, PositionArithmetic_ShouldMatchBitIndex) {
+  uint32_t seed = 9;
+  for (int i = 0; i < 1000; i++) {
+    ByteBuffer::BitPosition a(TestUtil::nextRandom(seed) >> 4);
+    ByteBuffer::BitPosition b(TestUtil::nextRandom(seed) >> 4);
+    uint32_t n = TestUtil::nextRandom(seed) >> 8;
+    ASSERT_EQ((a + b).getBitIndex(),a.getBitIndex() + b.getBitIndex());
+    ASSERT_EQ((a + static_cast<int>(n)).getBitIndex(),a.getBitIndex() + n);
+    if (b < a) {
+      ASSERT_EQ((a - b).getBitIndex(),a.getBitIndex() - b.getBitIndex());
+    }
+    ASSERT_EQ(a < b,a.getBitIndex() < b.getBitIndex());
+    ASSERT_EQ(a > b,a.getBitIndex() > b.getBitIndex());
+  }
+}
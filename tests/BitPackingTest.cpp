@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "BitPacking.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+std::vector<uint8_t> pack(const std::vector<uint32_t> &values) {
+  std::vector<uint8_t> out(ByteBuffer::maxPackedIntegerSize(values.size()));
+  size_t used = ByteBuffer::packIntegers(ByteBuffer::ByteBufferView(out.data(),out.size()),values.data(),values.size());
+  out.resize(used);
+  return out;
+}
+
+std::vector<uint32_t> unpack(const std::vector<uint8_t> &packed) {
+  ByteBuffer::ConstByteBufferView in(packed.data(),packed.size());
+  std::vector<uint32_t> values(ByteBuffer::packedIntegerCount(in));
+  EXPECT_TRUE(ByteBuffer::unpackIntegers(in,values.data(),values.size()));
+  return values;
+}
+
+}
+
+/***************************************************************************************************************
+ * Round trips
+ ***************************************************************************************************************/
+
+/// @brief test if values of every bit width survive packing, including a partial last block
+TEST(BitPacking, AllWidths_ShouldRoundTrip) {
+  uint32_t seed = 3;
+  for (unsigned b = 0; b <= 32; b++) {
+    std::vector<uint32_t> values(300);
+    for (uint32_t &v : values) {
+      v = b == 32 ? TestUtil::nextRandom(seed) : TestUtil::nextRandom(seed) & ((1u << b) - 1);
+    }
+    std::vector<uint8_t> packed = pack(values);
+    ASSERT_FALSE(packed.empty());
+    ASSERT_EQ(unpack(packed),values) << b;
+  }
+}
+
+/// @brief test if values in a narrow range are stored relative to the block minimum
+/// 128 values within 0..15 above a large reference take 4 bits each: 4 + 5 + 64 bytes
+TEST(BitPacking, SmallRange_ShouldUseFrameOfReference) {
+  std::vector<uint32_t> values(128);
+  uint32_t seed = 11;
+  for (uint32_t &v : values) {
+    v = 1000000u + (TestUtil::nextRandom(seed) & 15);
+  }
+  values[5] = 1000000u;
+  values[6] = 1000015u;
+  std::vector<uint8_t> packed = pack(values);
+  EXPECT_EQ(packed.size(),73u);
+  EXPECT_EQ(packed[8],4);
+  EXPECT_EQ(unpack(packed),values);
+}
+
+/// @brief test if sorted timestamps are delta coded with the width of their gaps
+TEST(BitPacking, SortedValues_ShouldUseDeltas) {
+  std::vector<uint32_t> values(1000);
+  uint32_t seed = 17;
+  uint32_t t = 1700000000u;
+  for (uint32_t &v : values) {
+    t += 1 + (TestUtil::nextRandom(seed) & 7);
+    v = t;
+  }
+  std::vector<uint8_t> packed = pack(values);
+  EXPECT_EQ(packed[8] & 0x80,0x80);
+  EXPECT_LT(packed.size(),values.size() * 4 / 5);
+  EXPECT_EQ(unpack(packed),values);
+}
+
+/// @brief test if an empty sequence packs into its count
+TEST(BitPacking, Empty_ShouldRoundTrip) {
+  std::vector<uint8_t> packed = pack({});
+  EXPECT_EQ(packed.size(),4u);
+  EXPECT_TRUE(unpack(packed).empty());
+}
+
+/***************************************************************************************************************
+ * Errors
+ ***************************************************************************************************************/
+
+/// @brief test if too small output buffers and truncated input are rejected
+TEST(BitPacking, ShortBuffers_ShouldFail) {
+  std::vector<uint32_t> values(200,0x12345);
+  values[3] = 7;
+  std::vector<uint8_t> packed = pack(values);
+  std::vector<uint8_t> small(packed.size() - 1);
+  EXPECT_EQ(ByteBuffer::packIntegers(ByteBuffer::ByteBufferView(small.data(),small.size()),values.data(),values.size()),0u);
+  std::vector<uint32_t> out(200);
+  EXPECT_FALSE(ByteBuffer::unpackIntegers(ByteBuffer::ConstByteBufferView(packed.data(),packed.size() - 1),out.data(),out.size()));
+  EXPECT_FALSE(ByteBuffer::unpackIntegers(ByteBuffer::ConstByteBufferView(packed.data(),packed.size()),out.data(),199));
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "BitRingBuffer.hpp"
+
+/***************************************************************************************************************
+ * Single thread
+ ***************************************************************************************************************/
+
+/// @brief test if a new ring buffer is empty
+/// A default constructed ring buffer has no bits to read and all bytes free
+TEST(BitRingBuffer, DefaultConstructionOfObject_ShouldBeEmpty) {
+  ByteBuffer::BitRingBuffer<16> rb;
+  uint8_t v = 0;
+
+  EXPECT_EQ(rb.availableBits(),0u);
+  EXPECT_EQ(rb.writableBytes(),16u);
+  EXPECT_FALSE(rb.read(v,1));
+}
+
+/// @brief test if reading fields across the wrap point is working
+/// Fields written as words are read back with odd widths across the wrap point
+TEST(BitRingBuffer, ReadFieldsAcrossWrapPoint_ShouldReturnWrittenBits) {
+  ByteBuffer::BitRingBuffer<8> rb;
+  uint32_t v = 0;
+
+  ASSERT_TRUE(rb.pushWord(static_cast<uint32_t>(0x12345678)));
+  ASSERT_TRUE(rb.pushWord(static_cast<uint16_t>(0xabcd)));
+  ASSERT_TRUE(rb.read(v,24));
+  EXPECT_EQ(v,0x345678u);
+  ASSERT_TRUE(rb.pushWord(static_cast<uint32_t>(0xdeadbeef)));
+  EXPECT_EQ(rb.writableBytes(),1u);
+
+  ASSERT_TRUE(rb.read(v,4));
+  EXPECT_EQ(v,0x2u);
+  ASSERT_TRUE(rb.read(v,20));
+  EXPECT_EQ(v,0xabcd1u);
+  ASSERT_TRUE(rb.read(v,32));
+  EXPECT_EQ(v,0xdeadbeefu);
+  EXPECT_EQ(rb.availableBits(),0u);
+}
+
+/// @brief test if a partially consumed byte is not overwritten
+/// The byte holding unread bits stays occupied until all its bits are read
+TEST(BitRingBuffer, PartiallyConsumedByte_ShouldNotBeWritable) {
+  ByteBuffer::BitRingBuffer<2> rb;
+  uint8_t v = 0;
+
+  ASSERT_TRUE(rb.pushWord(static_cast<uint16_t>(0xffff)));
+  ASSERT_TRUE(rb.read(v,7));
+  EXPECT_EQ(rb.writableBytes(),0u);
+  ASSERT_TRUE(rb.read(v,1));
+  EXPECT_EQ(rb.writableBytes(),1u);
+}
+
+/***************************************************************************************************************
+ * Producer and consumer threads
+ ***************************************************************************************************************/
+
+/// @brief test if a producer and a consumer thread exchange a long stream
+/// A stream of counter bytes is decoded in 13 bit fields without loss
+TEST(BitRingBuffer, ProducerAndConsumerThreads_ShouldTransferStreamWithoutLoss) {
+  ByteBuffer::BitRingBuffer<64> rb;
+  constexpr uint32_t count = 100000;
+
+  std::thread producer([&rb]() {
+    for (uint32_t i = 0; i < count; i++) {
+      while (!rb.pushWord(static_cast<uint16_t>(i & 0x1fff))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  bool ok = true;
+  for (uint32_t i = 0; i < count && ok; i++) {
+    uint16_t v = 0;
+    while (!rb.read(v,13)) {
+      std::this_thread::yield();
+    }
+    ok = (v == (i & 0x1fff));
+    while (!rb.skip(3)) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  EXPECT_TRUE(ok);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "BitTranspose.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+bool bitAt(const std::vector<uint8_t> &v, size_t i) {
+  return (v[i / 8] >> (i % 8)) & 1;
+}
+
+/// @brief check that every `w` x `w` block of `out` is the transpose of the same block of `in`
+void expectTransposed(const std::vector<uint8_t> &in, const std::vector<uint8_t> &out, size_t w) {
+  size_t block = w * w / 8;
+  for (size_t b = 0; b < in.size() / block; b++) {
+    for (size_t r = 0; r < w; r++) {
+      for (size_t c = 0; c < w; c++) {
+        ASSERT_EQ(bitAt(out,b * w * w + c * w + r),bitAt(in,b * w * w + r * w + c)) << b << " " << r << " " << c;
+      }
+    }
+  }
+}
+
+}
+
+/***************************************************************************************************************
+ * Transposes
+ ***************************************************************************************************************/
+
+/// @brief test if the 8x8 word transpose moves bit (r, c) to (c, r)
+TEST(BitTranspose, Transpose8x8Word_ShouldSwapRowsAndColumns) {
+  EXPECT_EQ(ByteBuffer::transpose8x8(0xffu),0x0101010101010101u);
+  EXPECT_EQ(ByteBuffer::transpose8x8(0x0101010101010101u),0xffu);
+  EXPECT_EQ(ByteBuffer::transpose8x8(0x8040201008040201u),0x8040201008040201u);
+  EXPECT_EQ(ByteBuffer::transpose8x8(0x0400u),0x020000u);
+}
+
+/// @brief test if all three block transposes match a bit-by-bit reference
+TEST(BitTranspose, TransposeBlocks_ShouldMatchReference) {
+  std::vector<uint8_t> in = TestUtil::pseudoRandom(1024 + 5,7);
+  std::vector<uint8_t> out(in.size());
+  ByteBuffer::ConstByteBufferView src(in.data(),in.size());
+  ByteBuffer::ByteBufferView dst(out.data(),out.size());
+  EXPECT_EQ(ByteBuffer::transpose8x8(src,dst),128u);
+  expectTransposed(in,out,8);
+  EXPECT_EQ(ByteBuffer::transpose16x16(src,dst),32u);
+  expectTransposed(in,out,16);
+  EXPECT_EQ(ByteBuffer::transpose64x64(src,dst),2u);
+  expectTransposed(in,out,64);
+}
+
+/// @brief test if transposing twice in place restores the data
+TEST(BitTranspose, TransposeInPlaceTwice_ShouldRestoreData) {
+  std::vector<uint8_t> in = TestUtil::pseudoRandom(512,11);
+  std::vector<uint8_t> v = in;
+  ByteBuffer::ByteBufferView view(v.data(),v.size());
+  ByteBuffer::transpose64x64(view,view);
+  EXPECT_NE(v,in);
+  ByteBuffer::transpose64x64(view,view);
+  EXPECT_EQ(v,in);
+}
+
+/***************************************************************************************************************
+ * Bit reversal
+ ***************************************************************************************************************/
+
+/// @brief test if bits are reversed inside each byte
+TEST(BitTranspose, ReverseBitsInBytes_ShouldMirrorEachByte) {
+  std::vector<uint8_t> v = TestUtil::pseudoRandom(37,3);
+  std::vector<uint8_t> in = v;
+  ByteBuffer::reverseBitsInBytes(ByteBuffer::ByteBufferView(v.data(),v.size()));
+  for (size_t i = 0; i < v.size(); i++) {
+    for (int b = 0; b < 8; b++) {
+      EXPECT_EQ((v[i] >> b) & 1,(in[i] >> (7 - b)) & 1);
+    }
+  }
+}
+
+/// @brief test if the whole buffer is reversed as one bit string
+/// Odd and even lengths around the vector width are checked against a bit-by-bit reference
+TEST(BitTranspose, ReverseBits_ShouldMirrorWholeBuffer) {
+  for (size_t n : {0u, 1u, 2u, 15u, 16u, 31u, 32u, 33u, 65u, 100u}) {
+    std::vector<uint8_t> v = TestUtil::pseudoRandom(n,static_cast<uint32_t>(n));
+    std::vector<uint8_t> in = v;
+    ByteBuffer::reverseBits(ByteBuffer::ByteBufferView(v.data(),v.size()));
+    for (size_t i = 0; i < n * 8; i++) {
+      ASSERT_EQ(bitAt(v,i),bitAt(in,n * 8 - 1 - i)) << n << " " << i;
+    }
+  }
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <bitset>
+#include <vector>
+
+#include "BitsetInterop.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+template <size_t N>
+std::bitset<N> randomBitset(uint64_t seed) {
+  std::bitset<N> b;
+  for (size_t i = 0; i < N; i++) {
+    b[i] = (TestUtil::nextRandom(seed) >> 40) & 1;
+  }
+  return b;
+}
+
+template <size_t N>
+void expectBitsetRoundTrip() {
+  std::bitset<N> b = randomBitset<N>(N);
+  std::vector<uint8_t> buf((N + 7) / 8 + 1,0xff);
+  ByteBuffer::ByteBufferView v(buf.data(),buf.size());
+  ByteBuffer::fromBitset(b,v);
+  for (size_t i = 0; i < N; i++) {
+    ASSERT_EQ(((buf[i / 8] >> (i % 8)) & 1) != 0,b[i]) << N << " " << i;
+  }
+  EXPECT_EQ(buf.back(),0xff);
+  EXPECT_EQ(ByteBuffer::toBitset<N>(v),b);
+}
+
+}
+
+/***************************************************************************************************************
+ * std::bitset
+ ***************************************************************************************************************/
+
+/// @brief test if bitsets of several sizes are copied bit-exact in both directions
+/// Bits of the buffer after the last bitset bit keep their value
+TEST(BitsetInterop, BitsetRoundTrip_ShouldKeepBits) {
+  expectBitsetRoundTrip<1>();
+  expectBitsetRoundTrip<13>();
+  expectBitsetRoundTrip<64>();
+  expectBitsetRoundTrip<100>();
+  expectBitsetRoundTrip<1000>();
+}
+
+/// @brief test if bitset words match the to_ullong value
+TEST(BitsetInterop, BitsetExportWords_ShouldMatchToUllong) {
+  std::bitset<40> b(0xab12345678ull);
+  uint64_t words[2] = {1,1};
+  EXPECT_EQ(ByteBuffer::exportWords(b,words,2),1u);
+  EXPECT_EQ(words[0],0xab12345678ull);
+  EXPECT_EQ(words[1],0u);
+  std::bitset<40> c;
+  uint64_t in[1] = {0xffffffffffffffffull};
+  ByteBuffer::importWords(c,in,1);
+  EXPECT_TRUE(c.all());
+  EXPECT_EQ(c.to_ullong(),0xffffffffffull);
+}
+
+/// @brief test if a fixed-size buffer can be built from a bitset
+TEST(BitsetInterop, MakeByteBuffer_ShouldHoldBitsetBits) {
+  std::bitset<12> b(0xa5c);
+  ByteBuffer::ByteBuffer<4> buf = ByteBuffer::makeByteBuffer<4>(b);
+  EXPECT_EQ(buf.get<uint32_t>(ByteBuffer::BitPosition(0,0),32),0xa5cu);
+}
+
+/***************************************************************************************************************
+ * std::vector<bool>
+ ***************************************************************************************************************/
+
+/// @brief test if bool vectors are copied bit-exact in both directions
+/// Stale bits behind the end of a shrunk vector do not leak into the words
+TEST(BitsetInterop, BoolVectorRoundTrip_ShouldKeepBits) {
+  std::vector<bool> b(300,true);
+  b.resize(133);
+  uint64_t seed = 3;
+  for (size_t i = 0; i < b.size(); i++) {
+    b[i] = (TestUtil::nextRandom(seed) >> 33) & 1;
+  }
+  uint64_t words[4];
+  EXPECT_EQ(ByteBuffer::exportWords(b,words,4),3u);
+  EXPECT_EQ(words[2] >> 5,0u);
+  EXPECT_EQ(words[3],0u);
+  std::vector<bool> back(133,true);
+  EXPECT_EQ(ByteBuffer::importWords(back,words,4),3u);
+  EXPECT_EQ(back,b);
+
+  std::vector<uint8_t> buf(17,0);
+  ByteBuffer::fromBoolVector(b,ByteBuffer::ByteBufferView(buf.data(),buf.size()));
+  std::vector<bool> all = ByteBuffer::toBoolVector(ByteBuffer::ConstByteBufferView(buf.data(),buf.size()));
+  ASSERT_EQ(all.size(),136u);
+  for (size_t i = 0; i < b.size(); i++) {
+    EXPECT_EQ(all[i],b[i]) << i;
+  }
+}
+
+/// @brief test if a growable buffer made from a bool vector has its exact bit size
+TEST(BitsetInterop, MakeDynamicByteBuffer_ShouldKeepBitSize) {
+  std::vector<bool> b = {true,false,true,true,false,false,true,false,true,true,false};
+  ByteBuffer::DynamicByteBuffer d = ByteBuffer::makeDynamicByteBuffer(b);
+  EXPECT_EQ(d.bitSize(),11u);
+  EXPECT_EQ(d.get<uint32_t>(ByteBuffer::BitPosition(0,0),11),0x34du);
+}
+
+/***************************************************************************************************************
+ * Raw words
+ ***************************************************************************************************************/
+
+/// @brief test if views export to and import from little-endian words
+TEST(BitsetInterop, ViewWords_ShouldRoundTrip) {
+  std::vector<uint8_t> buf = {1,2,3,4,5,6,7,8,9,10};
+  uint64_t words[3] = {7,7,7};
+  EXPECT_EQ(ByteBuffer::exportWords(ByteBuffer::ConstByteBufferView(buf.data(),buf.size()),words,3),2u);
+  EXPECT_EQ(words[0],0x0807060504030201ull);
+  EXPECT_EQ(words[1],0x0a09ull);
+  EXPECT_EQ(words[2],0u);
+  words[1] = 0xeeddull;
+  EXPECT_EQ(ByteBuffer::importWords(ByteBuffer::ByteBufferView(buf.data(),buf.size()),words,2),2u);
+  EXPECT_EQ(buf[8],0xdd);
+  EXPECT_EQ(buf[9],0xee);
+}
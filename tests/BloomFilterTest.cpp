@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "BloomFilter.hpp"
+
+namespace {
+
+uint64_t splitmix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+}
+
+/***************************************************************************************************************
+ * Single keys
+ ***************************************************************************************************************/
+
+/// @brief test if a key sets exactly one bit in each word of its block
+/// The expected bits follow the documented layout: block from the upper, bits from the salted lower hash half
+TEST(BloomFilter, Insert_ShouldSetOneBitPerBlockWord) {
+  const uint32_t salts[8] = {0x47b6137bu,0x44974d91u,0x8824ad5bu,0xa2b7289du,0x705495c7u,0x2df1424bu,0x9efc4947u,0x5c6bfb31u};
+  ByteBuffer::BlockedBloomFilter<256> f;
+  uint64_t hash = (static_cast<uint64_t>(0xc0000000u) << 32) | 0x12345678u;
+  f.insert(hash);
+  const uint8_t *block = f.getData() + 3 * 64;
+  for (size_t i = 0; i < 8; i++) {
+    uint64_t w;
+    std::memcpy(&w,block + i * 8,sizeof(w));
+    EXPECT_EQ(w,static_cast<uint64_t>(1) << ((0x12345678u * salts[i]) >> 26)) << i;
+  }
+  EXPECT_TRUE(f.contains(hash));
+}
+
+/// @brief test if inserted keys are always found and others rarely
+/// At 16 bits per key the false positive rate stays well below 2 percent
+TEST(BloomFilter, Contains_ShouldFindInsertedKeysWithFewFalsePositives) {
+  ByteBuffer::BlockedBloomFilter<8192> f;
+  const uint64_t keys = 8192 * 8 / 16;
+  for (uint64_t k = 0; k < keys; k++) {
+    f.insert(splitmix(k));
+  }
+  for (uint64_t k = 0; k < keys; k++) {
+    ASSERT_TRUE(f.contains(splitmix(k))) << k;
+  }
+  size_t falsePositives = 0;
+  for (uint64_t k = keys; k < keys + 100000; k++) {
+    falsePositives += f.contains(splitmix(k));
+  }
+  EXPECT_LT(falsePositives,2000u);
+}
+
+/***************************************************************************************************************
+ * Batches and serialization
+ ***************************************************************************************************************/
+
+/// @brief test if batched operations match the single-key ones
+TEST(BloomFilter, Batch_ShouldMatchSingleKeys) {
+  std::vector<uint64_t> hashes;
+  for (uint64_t k = 0; k < 300; k++) {
+    hashes.push_back(splitmix(k * 7));
+  }
+  ByteBuffer::BlockedBloomFilter<1024> batch;
+  ByteBuffer::BlockedBloomFilter<1024> single;
+  batch.insertBatch(hashes.data(),150);
+  for (size_t i = 0; i < 150; i++) {
+    single.insert(hashes[i]);
+  }
+  EXPECT_EQ(std::memcmp(batch.getData(),single.getData(),batch.size()),0);
+  uint64_t bitmap[5];
+  size_t hits = batch.containsBatch(hashes.data(),hashes.size(),bitmap);
+  size_t expected = 0;
+  for (size_t i = 0; i < hashes.size(); i++) {
+    bool c = batch.contains(hashes[i]);
+    expected += c;
+    EXPECT_EQ((bitmap[i / 64] >> (i % 64)) & 1,static_cast<uint64_t>(c));
+  }
+  EXPECT_EQ(hits,expected);
+  EXPECT_GE(hits,150u);
+}
+
+/// @brief test if a filter restored from its saved bytes answers the same
+TEST(BloomFilter, RestoreFromData_ShouldKeepKeys) {
+  ByteBuffer::BlockedBloomFilter<512> f;
+  for (uint64_t k = 0; k < 40; k++) {
+    f.insert(splitmix(k));
+  }
+  std::vector<uint8_t> saved(f.getData(),f.getData() + f.size());
+  ByteBuffer::BlockedBloomFilter<512> restored(ByteBuffer::ConstByteBufferView(saved.data(),saved.size()));
+  for (uint64_t k = 0; k < 40; k++) {
+    EXPECT_TRUE(restored.contains(splitmix(k)));
+  }
+  restored.clear();
+  EXPECT_FALSE(restored.contains(splitmix(0)));
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "ByteBufferPool.hpp"
+
+/***************************************************************************************************************
+ * ByteBuffer non-zeroing constructor
+ ***************************************************************************************************************/
+
+/// @brief test if the non-zeroing constructor keeps the size of the buffer
+/// Construction with the noInit tag creates a buffer of the requested size
+TEST(ByteBufferPool, NoInitConstructionOfObject_ShouldReturnCorrectSize) {
+  ByteBuffer::ByteBuffer<16> bp(ByteBuffer::noInit);
+
+  EXPECT_EQ(bp.size(),16);
+}
+
+/***************************************************************************************************************
+ * Arena
+ ***************************************************************************************************************/
+
+/// @brief test if the arena hands out cache line aligned and zeroed buffers
+/// Every buffer allocated with default zeroing is aligned and empty
+TEST(ByteBufferPool, ArenaAllocate_ShouldReturnAlignedZeroedBuffers) {
+  ByteBuffer::ByteBufferArena<10> arena(4);
+
+  for (int i = 0; i < 9; i++) {
+    ByteBuffer::ByteBuffer<10> *b = arena.allocate();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % ByteBuffer::cacheLineSize,0u);
+    for (size_t j = 0; j < b->size(); j++) {
+      EXPECT_EQ(b->getData()[j],0);
+    }
+    b->fill(0xff);
+  }
+  EXPECT_EQ(arena.slabCount(),3u);
+}
+
+/// @brief test if resetting the arena reuses the slabs
+/// After reset the generation is incremented and no new slab is allocated
+TEST(ByteBufferPool, ArenaReset_ShouldReuseSlabsAndIncrementGeneration) {
+  ByteBuffer::ByteBufferArena<10> arena(2);
+
+  ByteBuffer::ByteBuffer<10> *first = arena.allocate();
+  arena.allocate();
+  EXPECT_EQ(arena.generation(),0u);
+
+  arena.reset();
+  ByteBuffer::ByteBuffer<10> *again = arena.allocate();
+  arena.allocate();
+
+  EXPECT_EQ(arena.generation(),1u);
+  EXPECT_EQ(first,again);
+  EXPECT_EQ(arena.slabCount(),1u);
+}
+
+/***************************************************************************************************************
+ * Pool
+ ***************************************************************************************************************/
+
+/// @brief test if a released buffer is recycled without zeroing
+/// Acquiring with Zeroing::keep returns the released buffer with its previous content
+TEST(ByteBufferPool, AcquireReleasedBufferWithoutZeroing_ShouldKeepContent) {
+  ByteBuffer::ByteBufferPool<8> pool;
+
+  ByteBuffer::ByteBuffer<8> *b = pool.acquire();
+  b->set(ByteBuffer::bitPositionZero,static_cast<uint8_t>(0x5a),8);
+  pool.release(b);
+  EXPECT_EQ(pool.freeCount(),1u);
+
+  ByteBuffer::ByteBuffer<8> *c = pool.acquire(ByteBuffer::Zeroing::keep);
+  EXPECT_EQ(b,c);
+  EXPECT_EQ(pool.freeCount(),0u);
+  EXPECT_EQ(c->get<uint8_t>(ByteBuffer::bitPositionZero,8),0x5a);
+}
+
+/// @brief test if a released buffer is zeroed on request
+/// Acquiring with default zeroing returns an empty recycled buffer
+TEST(ByteBufferPool, AcquireReleasedBufferWithZeroing_ShouldReturnEmptyBuffer) {
+  ByteBuffer::ByteBufferPool<8> pool;
+
+  ByteBuffer::ByteBuffer<8> *b = pool.acquire();
+  b->fill(0xff);
+  pool.release(b);
+
+  ByteBuffer::ByteBuffer<8> *c = pool.acquire();
+  EXPECT_EQ(b,c);
+  EXPECT_EQ(c->get<uint64_t>(ByteBuffer::bitPositionZero,64),0u);
+}
+
+/// @brief test if resetting the pool drops the free list
+/// After reset the pool starts a new generation with an empty free list
+TEST(ByteBufferPool, ResetPool_ShouldClearFreeListAndIncrementGeneration) {
+  ByteBuffer::ByteBufferPool<8> pool;
+
+  pool.release(pool.acquire());
+  pool.release(pool.acquire());
+  pool.acquire();
+  pool.reset();
+
+  EXPECT_EQ(pool.freeCount(),0u);
+  EXPECT_EQ(pool.generation(),1u);
+}
+
+/// @brief test if the thread local pool is unique per thread
+/// Calling threadLocal twice on the same thread returns the same pool
+TEST(ByteBufferPool, ThreadLocalPool_ShouldReturnSamePoolOnSameThread) {
+  EXPECT_EQ(&ByteBuffer::ByteBufferPool<8>::threadLocal(),&ByteBuffer::ByteBufferPool<8>::threadLocal());
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ByteBufferQueue.hpp"
+
+/***************************************************************************************************************
+ * SPSC queue
+ ***************************************************************************************************************/
+
+/// @brief test if published buffers are read in order and in place
+TEST(ByteBufferQueue, SpscClaimPublishRead_ShouldPassBuffersInOrder) {
+  ByteBuffer::ByteBufferSpscQueue<16,4> q;
+  auto b = q.claim(3);
+  ASSERT_EQ(b.size(),3u);
+  for (size_t i = 0; i < b.size(); i++) {
+    b[i].set(ByteBuffer::BitPosition(0,0),static_cast<uint32_t>(i + 10),8);
+  }
+  EXPECT_FALSE(q.read());
+  q.publish(b);
+  auto r = q.read(8);
+  ASSERT_EQ(r.size(),3u);
+  for (size_t i = 0; i < r.size(); i++) {
+    EXPECT_EQ(r[i].get<uint32_t>(ByteBuffer::BitPosition(0,0),8),i + 10);
+  }
+  EXPECT_EQ(&r[0],&b[0]);
+  q.release(r);
+}
+
+/// @brief test if the producer cannot claim more slots than are free
+TEST(ByteBufferQueue, SpscClaimWhenFull_ShouldReturnEmptyBatch) {
+  ByteBuffer::ByteBufferSpscQueue<8,4> q;
+  auto a = q.claim(4);
+  EXPECT_EQ(a.size(),4u);
+  EXPECT_FALSE(q.claim());
+  q.publish(a);
+  auto r = q.read(2);
+  q.release(r);
+  EXPECT_EQ(q.claim(4).size(),2u);
+}
+
+/// @brief test if a producer and a consumer thread pass every buffer exactly once in order
+TEST(ByteBufferQueue, SpscThreads_ShouldDeliverEveryBufferInOrder) {
+  ByteBuffer::ByteBufferSpscQueue<64,64> q;
+  const uint32_t total = 200000;
+  std::thread producer([&q, total]() {
+    uint32_t next = 0;
+    while (next < total) {
+      auto b = q.claim(8);
+      if (!b) {
+        std::this_thread::yield();
+      }
+      for (size_t i = 0; i < b.size() && next < total; i++) {
+        b[i].set(ByteBuffer::BitPosition(60,0),next++,32);
+      }
+      q.publish(b);
+    }
+  });
+  uint32_t expected = 0;
+  bool ordered = true;
+  while (expected < total) {
+    auto r = q.read(8);
+    if (!r) {
+      std::this_thread::yield();
+    }
+    for (size_t i = 0; i < r.size(); i++) {
+      ordered = ordered && r[i].get<uint32_t>(ByteBuffer::BitPosition(60,0),32) == expected;
+      expected++;
+    }
+    q.release(r);
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+}
+
+/***************************************************************************************************************
+ * MPMC queue
+ ***************************************************************************************************************/
+
+/// @brief test if slots are free again only after they were released
+TEST(ByteBufferQueue, MpmcReleaseOutOfOrder_ShouldFreeSlots) {
+  ByteBuffer::ByteBufferMpmcQueue<8,2> q;
+  auto a = q.claim();
+  auto b = q.claim();
+  EXPECT_FALSE(q.claim());
+  q.publish(b);
+  EXPECT_FALSE(q.read());
+  q.publish(a);
+  auto r1 = q.read();
+  auto r2 = q.read();
+  ASSERT_TRUE(r1 && r2);
+  q.release(r2);
+  EXPECT_FALSE(q.claim());
+  q.release(r1);
+  EXPECT_EQ(q.claim(2).size(),2u);
+}
+
+/// @brief test if several producers and consumers pass every buffer exactly once
+/// The sum and count of all values seen by the consumers equal the values produced
+TEST(ByteBufferQueue, MpmcThreads_ShouldDeliverEveryBufferOnce) {
+  ByteBuffer::ByteBufferMpmcQueue<32,128> q;
+  const uint32_t perProducer = 50000;
+  const int producers = 3;
+  const int consumers = 3;
+  std::atomic<uint64_t> sum{0};
+  std::atomic<uint64_t> seen{0};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++) {
+    threads.emplace_back([&q, p, perProducer]() {
+      uint32_t next = 0;
+      while (next < perProducer) {
+        auto b = q.claim(4);
+        if (!b) {
+          std::this_thread::yield();
+        }
+        for (size_t i = 0; i < b.size(); i++) {
+          uint32_t v = next < perProducer ? static_cast<uint32_t>(p) * perProducer + next + 1 : 0;
+          next += next < perProducer ? 1 : 0;
+          b[i].set(ByteBuffer::BitPosition(4,0),v,32);
+        }
+        q.publish(b);
+      }
+    });
+  }
+  const uint64_t expectedCount = static_cast<uint64_t>(producers) * perProducer;
+  for (int c = 0; c < consumers; c++) {
+    threads.emplace_back([&q, &sum, &seen, expectedCount]() {
+      while (seen.load() < expectedCount) {
+        auto r = q.read(4);
+        if (!r) {
+          std::this_thread::yield();
+        }
+        for (size_t i = 0; i < r.size(); i++) {
+          uint32_t v = r[i].get<uint32_t>(ByteBuffer::BitPosition(4,0),32);
+          if (v != 0) {
+            sum += v;
+            seen++;
+          }
+        }
+        q.release(r);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(seen.load(),expectedCount);
+  EXPECT_EQ(sum.load(),expectedCount * (expectedCount + 1) / 2);
+}
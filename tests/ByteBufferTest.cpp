@@ -132,6 +132,22 @@ TEST(ByteBuffer, Insert32BitValueInEmptyBuffer_ShouldReturnByteBufferWithComplet
   EXPECT_EQ(memcmp(dataBuf1,&compareBuffer,sizeof(compareBuffer)),0);
 }
 
+/// @brief test if insert with a bit count wider than the value type is working
+/// Test if only the bits of the value type are written and the rest of the buffer keeps its value
+TEST(ByteBuffer, InsertWithBitCountWiderThanType_ShouldStopAtTypeWidth) {
+  ByteBuffer::ByteBuffer<4> bp1;
+  bp1.fill(0xff);
+  uint8_t data = 0x0f;
+
+  bp1.set(ByteBuffer::BitPosition(0,4),data,32);
+  const uint8_t *dataBuf1 = bp1.getData();
+
+  EXPECT_EQ(dataBuf1[0],0xff);
+  EXPECT_EQ(dataBuf1[1],0xf0);
+  EXPECT_EQ(dataBuf1[2],0xff);
+  EXPECT_EQ(dataBuf1[3],0xff);
+}
+
 /**********************************************************************************************************
  * get Value from Position
  **********************************************************************************************************/
@@ -202,6 +218,16 @@ TEST(ByteBuffer, GetToLargeBitRangeFromDefinedBuffer_ShouldReturnTruncatedValue)
   EXPECT_EQ(data,dataCompare);
 }
 
+/// @brief test if getting with a bit count wider than the return type is working
+/// Test if only as many bits as the return type holds are read
+TEST(ByteBuffer, GetWithBitCountWiderThanType_ShouldStopAtTypeWidth) {
+  ByteBuffer::ByteBuffer<4> bp1;
+  bp1.set(ByteBuffer::bitPositionZero,0xa5c3f1e2u,32);
+
+  uint8_t data = bp1.get<uint8_t>(ByteBuffer::BitPosition(0,4),24);
+  EXPECT_EQ(data,0x1e);
+}
+
 /**********************************************************************************************************
  * Operations with class Bit 
  **********************************************************************************************************/
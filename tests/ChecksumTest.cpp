@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "Checksum.hpp"
+
+namespace {
+
+const uint8_t checkInput[9] = {'1','2','3','4','5','6','7','8','9'};
+
+ByteBuffer::ConstByteBufferView checkView() {
+  return ByteBuffer::ConstByteBufferView(checkInput,sizeof(checkInput));
+}
+
+/// @brief copy `src` into a zeroed vector starting `shift` bits after the begin
+std::vector<uint8_t> shiftedCopy(const uint8_t *src, size_t n, uint8_t shift) {
+  std::vector<uint8_t> out(n + 2,0);
+  for (size_t i = 0; i < n; i++) {
+    out[i] = static_cast<uint8_t>(out[i] | (src[i] << shift));
+    out[i + 1] = static_cast<uint8_t>(src[i] >> (8 - shift));
+  }
+  return out;
+}
+
+}
+
+/***************************************************************************************************************
+ * Generic CRC check values
+ ***************************************************************************************************************/
+
+/// @brief test if the presets produce the catalogued check values
+/// The CRC of "123456789" equals the published check value of each algorithm
+TEST(Checksum, CrcOfCheckString_ShouldReturnCheckValue) {
+  EXPECT_EQ(ByteBuffer::Crc<uint8_t>(ByteBuffer::crc8Smbus).compute(checkView()),0xf4);
+  EXPECT_EQ(ByteBuffer::Crc<uint16_t>(ByteBuffer::crc16CcittFalse).compute(checkView()),0x29b1);
+  EXPECT_EQ(ByteBuffer::Crc<uint16_t>(ByteBuffer::crc16Arc).compute(checkView()),0xbb3d);
+  EXPECT_EQ(ByteBuffer::Crc<uint32_t>(ByteBuffer::crc32Ieee).compute(checkView()),0xcbf43926u);
+  EXPECT_EQ(ByteBuffer::Crc<uint64_t>(ByteBuffer::crc64Ecma).compute(checkView()),0x6c40df5f0b497347u);
+  EXPECT_EQ(ByteBuffer::Crc<uint64_t>(ByteBuffer::crc64Xz).compute(checkView()),0x995dc9bbdf1939fau);
+  EXPECT_EQ(ByteBuffer::crc32c(checkView()),0xe3069283u);
+}
+
+/// @brief test if a CRC over an unaligned range equals the CRC of the aligned bytes
+/// Shifting the data by some bits and computing over the shifted range does not change the CRC
+TEST(Checksum, CrcOverUnalignedRange_ShouldEqualAlignedCrc) {
+  ByteBuffer::Crc<uint16_t> crc16(ByteBuffer::crc16CcittFalse);
+
+  for (uint8_t shift = 1; shift < 8; shift++) {
+    std::vector<uint8_t> mem = shiftedCopy(checkInput,sizeof(checkInput),shift);
+    ByteBuffer::ConstByteBufferView v(mem.data(),mem.size());
+    ByteBuffer::BitRange range(ByteBuffer::BitPosition(0,shift),static_cast<uint16_t>(sizeof(checkInput) * 8));
+
+    EXPECT_EQ(ByteBuffer::crc32c(v,range),0xe3069283u);
+    EXPECT_EQ(crc16.compute(v,range),0x29b1);
+  }
+}
+
+/// @brief test if long unaligned ranges with trailing bits match a bitwise reference
+/// The word-wise CRC-32C equals a bit-by-bit reference over the same range
+TEST(Checksum, Crc32cOverLongRangeWithPartialBits_ShouldMatchBitwiseReference) {
+  std::vector<uint8_t> mem(100);
+  for (size_t i = 0; i < mem.size(); i++) {
+    mem[i] = static_cast<uint8_t>(i * 131 + 7);
+  }
+  ByteBuffer::ConstByteBufferView v(mem.data(),mem.size());
+  ByteBuffer::BitRange range(ByteBuffer::BitPosition(3,5),ByteBuffer::BitPosition(90,2));
+
+  uint32_t ref = 0xffffffff;
+  for (ByteBuffer::BitPosition pos = range.getStart(); pos <= range.getEnd(); pos++) {
+    ref ^= (mem[pos.getBytePos()] >> pos.getBitPos()) & 1u;
+    ref = (ref & 1) ? (ref >> 1) ^ 0x82f63b78u : ref >> 1;
+  }
+
+  EXPECT_EQ(ByteBuffer::crc32c(v,range),~ref);
+  EXPECT_EQ(ByteBuffer::Crc<uint32_t>(ByteBuffer::crc32Castagnoli).compute(v,range),~ref);
+}
+
+/***************************************************************************************************************
+ * Internet checksum
+ ***************************************************************************************************************/
+
+/// @brief test if the internet checksum matches the RFC 1071 example
+/// The example bytes of RFC 1071 sum up to 0xddf2 which complements to 0x220d
+TEST(Checksum, InternetChecksumOfRfcExample_ShouldReturnComplementedSum) {
+  const uint8_t data[8] = {0x00,0x01,0xf2,0x03,0xf4,0xf5,0xf6,0xf7};
+
+  EXPECT_EQ(ByteBuffer::internetChecksum(ByteBuffer::ConstByteBufferView(data,sizeof(data))),0x220d);
+}
+
+/// @brief test if the internet checksum of a ByteBuffer with odd length pads with zero
+/// An odd trailing byte is summed as the high byte of a padded word
+TEST(Checksum, InternetChecksumOfOddLength_ShouldPadWithZero) {
+  ByteBuffer::ByteBuffer<3> b;
+  b.set(ByteBuffer::bitPositionZero,static_cast<uint32_t>(0x563412),24);
+
+  EXPECT_EQ(ByteBuffer::internetChecksum(b),static_cast<uint16_t>(~(0x1234 + 0x5600)));
+}
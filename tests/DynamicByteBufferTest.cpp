@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "DynamicByteBuffer.hpp"
+
+/***************************************************************************************************************
+ * Constructors
+ ***************************************************************************************************************/
+
+/// @brief test if construction with a size is working
+/// Construction with a size creates a zeroed buffer using the inline storage
+TEST(DynamicByteBuffer, ConstructionWithSize_ShouldReturnZeroedBuffer) {
+  ByteBuffer::DynamicByteBuffer b(4);
+
+  EXPECT_EQ(b.size(),4u);
+  EXPECT_EQ(b.capacity(),ByteBuffer::dynamicInlineCapacity);
+  EXPECT_EQ(b.get<uint32_t>(ByteBuffer::bitPositionZero,32),0u);
+}
+
+/// @brief test if moving a heap buffer steals the storage
+/// Moving a large buffer keeps the data pointer and empties the source
+TEST(DynamicByteBuffer, MoveConstructionOfHeapBuffer_ShouldStealStorage) {
+  ByteBuffer::DynamicByteBuffer a(100);
+  a.set(ByteBuffer::BitPosition(99,0),static_cast<uint8_t>(0xab),8);
+  const uint8_t *data = a.getData();
+
+  ByteBuffer::DynamicByteBuffer b(std::move(a));
+
+  EXPECT_EQ(b.getData(),data);
+  EXPECT_EQ(b.get<uint8_t>(ByteBuffer::BitPosition(99,0),8),0xab);
+  EXPECT_EQ(a.size(),0u);
+}
+
+/// @brief test if moving an inline buffer copies the content
+/// Moving a small buffer keeps the content in the inline storage of the target
+TEST(DynamicByteBuffer, MoveAssignmentOfInlineBuffer_ShouldCopyContent) {
+  ByteBuffer::DynamicByteBuffer a(2);
+  ByteBuffer::DynamicByteBuffer b(64);
+  a.set(ByteBuffer::bitPositionZero,static_cast<uint16_t>(0x1234),16);
+
+  b = std::move(a);
+
+  EXPECT_EQ(b.size(),2u);
+  EXPECT_EQ(b.get<uint16_t>(ByteBuffer::bitPositionZero,16),0x1234);
+}
+
+/// @brief test if an explicit copy is independent of the original
+/// Changing the clone does not change the original
+TEST(DynamicByteBuffer, CloneOfBuffer_ShouldBeIndependent) {
+  ByteBuffer::DynamicByteBuffer a(40);
+  a.fill(0x11);
+
+  ByteBuffer::DynamicByteBuffer b = a.clone();
+  b.fill(0x22);
+
+  EXPECT_EQ(a.getData()[39],0x11);
+  EXPECT_EQ(b.getData()[39],0x22);
+}
+
+/***************************************************************************************************************
+ * Append and growth
+ ***************************************************************************************************************/
+
+/// @brief test if appending fields grows the buffer
+/// Appending fields beyond the inline capacity moves the data to the heap and keeps all fields
+TEST(DynamicByteBuffer, AppendFieldsPastEnd_ShouldGrowAndKeepFields) {
+  ByteBuffer::DynamicByteBuffer b;
+
+  for (uint32_t i = 0; i < 100; i++) {
+    b.append(i,7);
+  }
+
+  EXPECT_EQ(b.bitSize(),700u);
+  EXPECT_EQ(b.size(),88u);
+  EXPECT_GE(b.capacity(),88u);
+  for (uint32_t i = 0; i < 100; i++) {
+    ASSERT_EQ(b.get<uint32_t>(ByteBuffer::BitPosition(i * 7),7),i);
+  }
+}
+
+/// @brief test if reserve avoids reallocation
+/// Appending within the reserved capacity keeps the data pointer
+TEST(DynamicByteBuffer, AppendWithinReservedCapacity_ShouldNotReallocate) {
+  ByteBuffer::DynamicByteBuffer b;
+  b.reserve(1000);
+  const uint8_t *data = b.getData();
+
+  for (int i = 0; i < 125; i++) {
+    b.append(static_cast<uint64_t>(i),64);
+  }
+
+  EXPECT_EQ(b.getData(),data);
+  EXPECT_EQ(b.size(),1000u);
+}
+
+/***************************************************************************************************************
+ * Bit access
+ ***************************************************************************************************************/
+
+/// @brief test if the proxies of at() are working
+/// Bit and Bits proxies read and write like on a ByteBuffer
+TEST(DynamicByteBuffer, SetAndGetUsingAt_ShouldReturnValueInBuffer) {
+  ByteBuffer::DynamicByteBuffer b(6);
+
+  b.at(ByteBuffer::bitPositionZero,ByteBuffer::Byte(4)).setValue(0x7f454c46);
+  b.at(ByteBuffer::BitPosition(5,0)).set();
+
+  EXPECT_TRUE(b.at(ByteBuffer::bitPositionZero,ByteBuffer::Byte(4)).hasValue(0x7f454c46));
+  EXPECT_TRUE(b.at(ByteBuffer::BitPosition(5,0)).isSet());
+  EXPECT_TRUE(b.at(ByteBuffer::BitPosition(5,1)).isCleared());
+}
+
+/// @brief test if getting a value beyond the end is truncated
+/// Reading more bits than available returns only the bits inside the buffer
+TEST(DynamicByteBuffer, GetTooLargeBitRange_ShouldReturnTruncatedValue) {
+  ByteBuffer::DynamicByteBuffer b(2);
+  b.fill(0xff);
+
+  EXPECT_EQ(b.get<uint32_t>(ByteBuffer::BitPosition(1,4),16),0xfu);
+}
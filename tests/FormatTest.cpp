@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "Format.hpp"
+
+/***************************************************************************************************************
+ * Values and positions
+ ***************************************************************************************************************/
+
+/// @brief test if decimal formatting matches std::to_string
+/// Values around every power of ten and the maximum are written like std::to_string does
+TEST(Format, FormatDecimal_ShouldMatchToString) {
+  char buf[32];
+  uint64_t v = 1;
+  for (int i = 0; i < 20; i++) {
+    for (uint64_t x : {v - 1, v, v + 1}) {
+      size_t n = ByteBuffer::formatDecimal(buf,sizeof(buf),x);
+      EXPECT_EQ(std::string(buf,n),std::to_string(x));
+    }
+    v *= 10;
+  }
+  size_t n = ByteBuffer::formatDecimal(buf,sizeof(buf),UINT64_MAX);
+  EXPECT_EQ(std::string(buf,n),"18446744073709551615");
+}
+
+/// @brief test if a too small output writes nothing
+/// A capacity below the required length returns 0 and leaves the output untouched
+TEST(Format, FormatIntoSmallBuffer_ShouldWriteNothing) {
+  char buf[4] = {'x','x','x','x'};
+  EXPECT_EQ(ByteBuffer::formatDecimal(buf,4,12345),0u);
+  EXPECT_EQ(ByteBuffer::formatHexValue(buf,4,0x12345),0u);
+  EXPECT_EQ(std::string(buf,4),"xxxx");
+}
+
+/// @brief test if hex values are padded to the requested digits
+TEST(Format, FormatHexValue_ShouldPadToMinDigits) {
+  char buf[32];
+  EXPECT_EQ(std::string(buf,ByteBuffer::formatHexValue(buf,sizeof(buf),0xbeef)),"beef");
+  EXPECT_EQ(std::string(buf,ByteBuffer::formatHexValue(buf,sizeof(buf),0x2a,8)),"0000002a");
+  EXPECT_EQ(std::string(buf,ByteBuffer::formatHexValue(buf,sizeof(buf),0)),"0");
+  EXPECT_EQ(std::string(buf,ByteBuffer::formatHexValue(buf,sizeof(buf),UINT64_MAX)),"ffffffffffffffff");
+}
+
+/// @brief test if positions are written like operator<<
+TEST(Format, FormatPosition_ShouldMatchStreamOutput) {
+  char buf[32];
+  ByteBuffer::BitPosition pos(1234,5);
+  std::ostringstream os;
+  os << pos;
+  EXPECT_EQ(std::string(buf,ByteBuffer::formatPosition(buf,sizeof(buf),pos)),os.str());
+}
+
+/***************************************************************************************************************
+ * Hex and hex dump
+ ***************************************************************************************************************/
+
+/// @brief test if every byte value is written as two lower-case hex digits
+/// The buffer is long enough to exercise the vector path as well as the tail
+TEST(Format, FormatHex_ShouldWriteTwoDigitsPerByte) {
+  uint8_t data[256 + 7];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  char buf[2 * sizeof(data)];
+  ASSERT_EQ(ByteBuffer::formatHex(buf,sizeof(buf),ByteBuffer::ConstByteBufferView(data,sizeof(data))),sizeof(buf));
+  const char *digits = "0123456789abcdef";
+  for (size_t i = 0; i < sizeof(data); i++) {
+    EXPECT_EQ(buf[2 * i],digits[data[i] >> 4]);
+    EXPECT_EQ(buf[2 * i + 1],digits[data[i] & 0xf]);
+  }
+}
+
+/// @brief test if the hex dump prints offsets and 16 bytes per line
+TEST(Format, FormatHexDump_ShouldPrintOffsetAndSixteenBytesPerLine) {
+  ByteBuffer::ByteBuffer<18> b;
+  for (size_t i = 0; i < b.size(); i++) {
+    b.data()[i] = static_cast<uint8_t>(0xa0 + i);
+  }
+  char buf[ByteBuffer::hexDumpSize(18)];
+  size_t n = ByteBuffer::formatHexDump(buf,sizeof(buf),b);
+  ASSERT_EQ(n,sizeof(buf));
+  EXPECT_EQ(std::string(buf,n),
+            "00000000  a0 a1 a2 a3 a4 a5 a6 a7 a8 a9 aa ab ac ad ae af\n"
+            "00000010  b0 b1\n");
+}
+
+/***************************************************************************************************************
+ * Bit ranges and fields
+ ***************************************************************************************************************/
+
+/// @brief test if bits are written in position order
+/// An unaligned range crossing bytes prints the bit at the start position first
+TEST(Format, FormatBits_ShouldWriteBitsInPositionOrder) {
+  ByteBuffer::ByteBuffer<4> b;
+  b.set(ByteBuffer::BitPosition(0,6),0x2d5u,10);
+  ByteBuffer::BitRange range(ByteBuffer::BitPosition(0,6),ByteBuffer::BitPosition(1,7));
+  char buf[16];
+  size_t n = ByteBuffer::formatBits(buf,sizeof(buf),b,range);
+  std::string expected;
+  for (int i = 0; i < 10; i++) {
+    expected += ((0x2d5 >> i) & 1) ? '1' : '0';
+  }
+  EXPECT_EQ(std::string(buf,n),expected);
+}
+
+/// @brief test if ranges are annotated with their positions
+TEST(Format, FormatRange_ShouldPrefixPositions) {
+  ByteBuffer::ByteBuffer<4> b;
+  b.set(ByteBuffer::BitPosition(1,2),0x5u,3);
+  ByteBuffer::BitRange range(ByteBuffer::BitPosition(1,2),ByteBuffer::BitPosition(1,4));
+  char buf[32];
+  size_t n = ByteBuffer::formatRange(buf,sizeof(buf),b,range);
+  EXPECT_EQ(std::string(buf,n),"1.2 .. 1.4: 101");
+  EXPECT_EQ(ByteBuffer::formatRange(buf,12,b,range),0u);
+}
+
+/// @brief test if a field value equals the value returned by get
+TEST(Format, FormatField_ShouldMatchGet) {
+  ByteBuffer::ByteBuffer<16> b;
+  ByteBuffer::BitRange range(ByteBuffer::BitPosition(2,3),ByteBuffer::BitPosition(7,1));
+  b.set(range,0x2fedcba987ull);
+  char buf[32];
+  size_t n = ByteBuffer::formatField(buf,sizeof(buf),b,range);
+  EXPECT_EQ(std::string(buf,n),std::to_string(b.get<uint64_t>(range)));
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "Huffman.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+/// @brief code lengths of a skewed alphabet with codes from 1 up to `longest` bits
+std::vector<uint8_t> skewedLengths(uint8_t longest) {
+  std::vector<uint8_t> lengths;
+  for (uint8_t l = 1; l < longest; l++) {
+    lengths.push_back(l);
+  }
+  lengths.push_back(longest);
+  lengths.push_back(longest);
+  return lengths;
+}
+
+std::vector<uint16_t> symbolStream(size_t n, size_t symbols) {
+  std::vector<uint16_t> out(n);
+  uint32_t seed = 1;
+  for (size_t i = 0; i < n; i++) {
+    // favour small symbols like the skewed code does
+    out[i] = static_cast<uint16_t>(__builtin_ctz((TestUtil::nextLcg(seed) >> 8) | (1u << 23)) % symbols);
+  }
+  return out;
+}
+
+}
+
+/***************************************************************************************************************
+ * Canonical code
+ ***************************************************************************************************************/
+
+/// @brief test if canonical codes follow the DEFLATE assignment
+/// Lengths (2,1,3,3) give the codes 10, 0, 110, 111 written first bit first
+TEST(Huffman, CanonicalCodes_ShouldFollowDeflateOrder) {
+  ByteBuffer::HuffmanCode code({2,1,3,3});
+  EXPECT_EQ(code.code(0),0x1u);   // 10 reversed
+  EXPECT_EQ(code.code(1),0x0u);   // 0
+  EXPECT_EQ(code.code(2),0x3u);   // 110 reversed
+  EXPECT_EQ(code.code(3),0x7u);   // 111
+  EXPECT_EQ(code.maxLength(),3u);
+}
+
+/// @brief test if invalid length tables are rejected
+TEST(Huffman, OversubscribedLengths_ShouldThrow) {
+  EXPECT_THROW(ByteBuffer::HuffmanCode({1,1,1}),std::invalid_argument);
+  EXPECT_THROW(ByteBuffer::HuffmanCode({25}),std::invalid_argument);
+}
+
+/***************************************************************************************************************
+ * Round trips
+ ***************************************************************************************************************/
+
+/// @brief test if encoded symbols decode back for codes shorter and longer than the primary table
+/// Long codes use secondary tables, short ones are paired up in one lookup
+TEST(Huffman, EncodeDecode_ShouldRoundTrip) {
+  for (int longest : {4, 11, 15, 24}) {
+    std::vector<uint8_t> lengths = skewedLengths(static_cast<uint8_t>(longest));
+    ByteBuffer::HuffmanEncoder enc(lengths);
+    ByteBuffer::HuffmanDecoder dec(lengths);
+    std::vector<uint16_t> syms = symbolStream(5000,lengths.size());
+    std::vector<uint8_t> buf(5000 * 3 + 1,0xff);
+    ByteBuffer::BitPosition start(0,3);
+    ByteBuffer::BitPosition end = enc.encode(ByteBuffer::ByteBufferView(buf.data(),buf.size()),start,syms.data(),syms.size());
+    ASSERT_NE(end,ByteBuffer::bitPositionMax);
+    EXPECT_EQ(buf[0] & 0x7,0x7);
+    std::vector<uint16_t> decoded(syms.size() + 10);
+    ByteBuffer::BitPosition decEnd;
+    size_t n = dec.decode(ByteBuffer::ConstByteBufferView(buf.data(),end.getBytePos() + 1),start,decoded.data(),syms.size(),&decEnd);
+    ASSERT_EQ(n,syms.size()) << longest;
+    decoded.resize(n);
+    EXPECT_EQ(decoded,syms);
+    EXPECT_EQ(decEnd,end);
+  }
+}
+
+/// @brief test if decoding stops at the end of the input
+/// The padding bits of the last byte do not produce extra symbols once the input is exhausted
+TEST(Huffman, DecodeTruncatedInput_ShouldStopAtEnd) {
+  std::vector<uint8_t> lengths = {1,2,3,3};
+  ByteBuffer::HuffmanEncoder enc(lengths);
+  ByteBuffer::HuffmanDecoder dec(lengths,4);
+  std::vector<uint16_t> syms = {3,2,3,2,1};
+  ByteBuffer::DynamicByteBuffer out;
+  ASSERT_TRUE(enc.encode(out,syms.data(),syms.size()));
+  EXPECT_EQ(out.bitSize(),14u);
+  uint16_t decoded[8];
+  size_t n = dec.decode(ByteBuffer::ConstByteBufferView(out.getData(),1),ByteBuffer::bitPositionZero,decoded,8);
+  EXPECT_EQ(n,2u);
+  EXPECT_EQ(decoded[0],3);
+  EXPECT_EQ(decoded[1],2);
+}
+
+/// @brief test if a bit pattern without a code stops decoding
+TEST(Huffman, DecodeUnusedPattern_ShouldStop) {
+  ByteBuffer::HuffmanDecoder dec({1,2});
+  uint8_t data[2] = {0x06,0xff};
+  uint16_t decoded[8];
+  ByteBuffer::BitPosition end;
+  EXPECT_EQ(dec.decode(ByteBuffer::ConstByteBufferView(data,2),ByteBuffer::bitPositionZero,decoded,8,&end),1u);
+  EXPECT_EQ(end,ByteBuffer::BitPosition(0,1));
+}
+
+/// @brief test if an unknown symbol is rejected by the encoder
+TEST(Huffman, EncodeUnknownSymbol_ShouldFail) {
+  ByteBuffer::HuffmanEncoder enc({1,0,1});
+  uint16_t syms[2] = {0,1};
+  uint8_t buf[4] = {0};
+  EXPECT_EQ(enc.encode(ByteBuffer::ByteBufferView(buf,4),ByteBuffer::bitPositionZero,syms,2),ByteBuffer::bitPositionMax);
+  ByteBuffer::DynamicByteBuffer out;
+  EXPECT_FALSE(enc.encode(out,syms,2));
+  EXPECT_EQ(out.bitSize(),0u);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "ByteBuffer.hpp"
+
+/***************************************************************************************************************
+ * Access counters (built with BYTEBUFFER_INSTRUMENTATION)
+ ***************************************************************************************************************/
+
+/// @brief test if get and set calls are counted by width
+/// Every get/set call increments the counter of its value width
+TEST(Instrumentation, GetAndSetCalls_ShouldBeCountedByWidth) {
+  ByteBuffer::instrumentation::reset();
+  ByteBuffer::ByteBuffer<8> bp;
+
+  bp.set(ByteBuffer::bitPositionZero,static_cast<uint8_t>(0x12),8);
+  bp.set(ByteBuffer::BitPosition(1,0),static_cast<uint32_t>(0x12345678),32);
+  bp.get<uint16_t>(ByteBuffer::BitPosition(0,4),12);
+
+  ByteBuffer::instrumentation::AccessStats stats = ByteBuffer::instrumentation::snapshot();
+  EXPECT_EQ(stats.setCalls[0],1u);
+  EXPECT_EQ(stats.setCalls[2],1u);
+  EXPECT_EQ(stats.getCalls[1],1u);
+  EXPECT_EQ(stats.bytesTouched,1u + 4u + 2u);
+  EXPECT_EQ(stats.alignedAccesses,2u);
+  EXPECT_EQ(stats.unalignedAccesses,1u);
+}
+
+/// @brief test if proxy constructions are counted
+/// Every call of at() creates exactly one proxy
+TEST(Instrumentation, AtCalls_ShouldCountProxyConstructions) {
+  ByteBuffer::instrumentation::reset();
+  ByteBuffer::ByteBuffer<2> bp;
+
+  bp.at(ByteBuffer::bitPositionZero).set();
+  bp.at(ByteBuffer::BitPosition(1,0),ByteBuffer::Byte(1)).setValue(3);
+
+  EXPECT_EQ(ByteBuffer::instrumentation::snapshot().proxyConstructions,2u);
+}
+
+/// @brief test if truncated accesses are counted
+/// Accessing more bits than the buffer holds counts one truncation
+TEST(Instrumentation, AccessBeyondBufferEnd_ShouldCountTruncation) {
+  ByteBuffer::instrumentation::reset();
+  ByteBuffer::ByteBuffer<2> bp;
+
+  bp.get<uint32_t>(ByteBuffer::BitPosition(1,0),16);
+  bp.get<uint32_t>(ByteBuffer::BitPosition(1,0),8);
+
+  EXPECT_EQ(ByteBuffer::instrumentation::snapshot().truncations,1u);
+}
+
+/// @brief test if counters of other threads are included in the snapshot
+/// Accesses on a second thread show up in the summed snapshot
+TEST(Instrumentation, AccessesOnOtherThread_ShouldBeIncludedInSnapshot) {
+  ByteBuffer::instrumentation::reset();
+
+  std::thread t([]() {
+    ByteBuffer::ByteBuffer<8> bp;
+    bp.get<uint64_t>(ByteBuffer::bitPositionZero,64);
+  });
+  t.join();
+
+  EXPECT_EQ(ByteBuffer::instrumentation::snapshot().getCalls[3],1u);
+}
+
+/// @brief test if the text dump contains every counter
+/// Streaming a snapshot writes one line per counter
+TEST(Instrumentation, DumpSnapshot_ShouldWriteAllCounters) {
+  ByteBuffer::instrumentation::reset();
+  std::ostringstream os;
+
+  os << ByteBuffer::instrumentation::snapshot();
+
+  EXPECT_NE(os.str().find("get64 0\n"),std::string::npos);
+  EXPECT_NE(os.str().find("truncations 0\n"),std::string::npos);
+}
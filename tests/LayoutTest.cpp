@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "Layout.hpp"
+
+namespace {
+
+// layout of examples/main.cpp: 32 bit magic, one byte id, flag bit and 3 bit type
+struct Magic : ByteBuffer::Field<0,32> {};
+struct Id : ByteBuffer::Field<32,8,uint8_t> {};
+struct Flag : ByteBuffer::Field<40,1,bool> {};
+struct Type : ByteBuffer::Field<41,3,uint8_t> {};
+// field crossing a 64 bit word border
+struct Wide : ByteBuffer::Field<60,40,uint64_t> {};
+// signed fields narrower than their type, one crossing a word border
+struct Delta : ByteBuffer::Field<0,4,int8_t> {};
+struct Offset : ByteBuffer::Field<58,12,int16_t> {};
+
+using Header = ByteBuffer::Layout<6,Magic,Id,Flag,Type>;
+using Frame = ByteBuffer::Layout<16,Wide>;
+using Signed = ByteBuffer::Layout<9,Delta,Offset>;
+
+static_assert(ByteBuffer::detail::fieldsDisjoint<Magic,Id,Flag,Type>(),"header fields overlap");
+static_assert(!ByteBuffer::detail::fieldsDisjoint<Magic,ByteBuffer::Field<31,2>>(),"overlap not detected");
+static_assert(!ByteBuffer::detail::fieldsFit<5,Magic,Id,Flag>(),"overflow not detected");
+
+}
+
+/***************************************************************************************************************
+ * Single field access
+ ***************************************************************************************************************/
+
+/// @brief test if named fields are written at their bit ranges
+/// Values set through the layout are read back through the bit ranges of the ByteBuffer
+TEST(Layout, SetNamedFields_ShouldWriteBitRanges) {
+  ByteBuffer::ByteBuffer<6> b;
+  Header h(b);
+
+  h.set<Magic>(0x7f454c46);
+  h.set<Id>(0x12);
+  h.set<Flag>(true);
+  h.set<Type>(2);
+
+  EXPECT_TRUE(b.at(ByteBuffer::bitPositionZero,ByteBuffer::Byte(4)).hasValue(0x7f454c46));
+  EXPECT_TRUE(b.at(ByteBuffer::BitPosition(4,0),ByteBuffer::Byte(1)).hasValue(0x12));
+  EXPECT_TRUE(b.at(ByteBuffer::BitPosition(5,0)).isSet());
+  EXPECT_TRUE(b.at(Type::range()).hasValue(2));
+  EXPECT_EQ(h.get<Type>(),2);
+  EXPECT_EQ(h.get<Magic>(),0x7f454c46u);
+}
+
+/// @brief test if setting a field keeps neighbouring bits
+/// Writing a field only changes the bits of that field
+TEST(Layout, SetFieldBetweenSetBits_ShouldKeepNeighbouringBits) {
+  ByteBuffer::ByteBuffer<16> b;
+  b.fill(0xff);
+  Frame f(b);
+
+  f.set<Wide>(0);
+
+  EXPECT_EQ(b.get<uint8_t>(ByteBuffer::BitPosition(7,0),4),0xf);
+  EXPECT_EQ(b.get<uint8_t>(ByteBuffer::BitPosition(12,4),4),0xf);
+  EXPECT_EQ(f.get<Wide>(),0u);
+  EXPECT_EQ(b.get<uint64_t>(ByteBuffer::BitPosition(60),40),0u);
+}
+
+/// @brief test if signed fields narrower than their type are sign-extended
+/// A 4 bit field holding -1 reads back as -1, not 15, and positive values keep their value
+TEST(Layout, GetSignedNarrowField_ShouldSignExtend) {
+  ByteBuffer::ByteBuffer<9> b;
+  Signed s(b);
+
+  s.set<Delta>(-1);
+  s.set<Offset>(-2048);
+
+  EXPECT_EQ(b.get<uint8_t>(ByteBuffer::bitPositionZero,4),0xf);
+  EXPECT_EQ(s.get<Delta>(),-1);
+  EXPECT_EQ(s.get<Offset>(),-2048);
+
+  s.set<Delta>(7);
+  s.set<Offset>(2047);
+
+  EXPECT_EQ(s.get<Delta>(),7);
+  EXPECT_EQ(s.get<Offset>(),2047);
+}
+
+/***************************************************************************************************************
+ * Fused decode and encode
+ ***************************************************************************************************************/
+
+/// @brief test if encodeAll and decodeAll round trip all fields
+/// All fields written at once are read back at once with the same values
+TEST(Layout, EncodeAllThenDecodeAll_ShouldReturnSameValues) {
+  ByteBuffer::ByteBuffer<6> b;
+  Header h(b);
+
+  h.encodeAll(Header::Values(0xdeadbeef,0x34,false,5));
+  Header::Values v = h.decodeAll();
+
+  EXPECT_EQ(std::get<0>(v),0xdeadbeefu);
+  EXPECT_EQ(std::get<1>(v),0x34);
+  EXPECT_FALSE(std::get<2>(v));
+  EXPECT_EQ(std::get<3>(v),5);
+  EXPECT_EQ(b.get<uint8_t>(ByteBuffer::BitPosition(5,1),3),5);
+}
+
+/// @brief test if fields crossing word borders are encoded
+/// A 40 bit field starting at bit 60 round trips through encodeAll and decodeAll
+TEST(Layout, EncodeAllFieldAcrossWordBorder_ShouldRoundTrip) {
+  ByteBuffer::ByteBuffer<16> b;
+  Frame f(b);
+
+  f.encodeAll(Frame::Values(0xab12345678u));
+
+  EXPECT_EQ(std::get<0>(f.decodeAll()),0xab12345678u);
+  EXPECT_EQ(b.get<uint64_t>(ByteBuffer::BitPosition(60),40),0xab12345678u);
+}
+
+/// @brief test if decodeAll sign-extends signed fields like get
+TEST(Layout, DecodeAllSignedNarrowFields_ShouldSignExtend) {
+  ByteBuffer::ByteBuffer<9> b;
+  Signed s(b);
+
+  s.encodeAll(Signed::Values(-8,-1));
+  Signed::Values v = s.decodeAll();
+
+  EXPECT_EQ(std::get<0>(v),-8);
+  EXPECT_EQ(std::get<1>(v),-1);
+  EXPECT_EQ(b.get<uint16_t>(ByteBuffer::BitPosition(58),12),0xfff);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Morton.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+/// @brief check bit `i * D + d` of the key at `start` against bit `i` of coordinate `d`
+void expectKey(const std::vector<uint8_t> &buf, uint64_t start, const uint32_t *c, unsigned dims) {
+  for (unsigned i = 0; i < 32; i++) {
+    for (unsigned d = 0; d < dims; d++) {
+      uint64_t bit = start + i * dims + d;
+      ASSERT_EQ(static_cast<uint32_t>((buf[bit / 8] >> (bit % 8)) & 1),(c[d] >> i) & 1) << i << " " << d;
+    }
+  }
+}
+
+}
+
+/***************************************************************************************************************
+ * Keys
+ ***************************************************************************************************************/
+
+/// @brief test if the 2D key interleaves x into the even and y into the odd bits
+TEST(Morton, Morton2_ShouldInterleaveBits) {
+  EXPECT_EQ(ByteBuffer::morton2(0xffffffffu,0),0x5555555555555555u);
+  EXPECT_EQ(ByteBuffer::morton2(0,0xffffffffu),0xaaaaaaaaaaaaaaaau);
+  EXPECT_EQ(ByteBuffer::morton2(0x5,0x3),0x1bu);
+  uint32_t x = 0;
+  uint32_t y = 0;
+  ByteBuffer::morton2Decode(ByteBuffer::morton2(0x12345678u,0x9abcdef0u),x,y);
+  EXPECT_EQ(x,0x12345678u);
+  EXPECT_EQ(y,0x9abcdef0u);
+}
+
+/// @brief test if keys of 2, 3 and 4 coordinates are written bit-exact at an unaligned position
+/// Bits around the key keep their value and the key reads back into the coordinates
+TEST(Morton, InterleaveDeinterleave_ShouldRoundTrip) {
+  uint32_t seed = 5;
+  for (int round = 0; round < 50; round++) {
+    uint32_t c[4] = {TestUtil::nextRandom(seed),TestUtil::nextRandom(seed),TestUtil::nextRandom(seed),TestUtil::nextRandom(seed)};
+    ByteBuffer::BitPosition pos(1,static_cast<uint8_t>(round % 8));
+    uint64_t start = 8 + round % 8;
+    std::vector<uint8_t> buf(20,0xa5);
+    ByteBuffer::ByteBufferView v(buf.data(),buf.size());
+    uint32_t out[4] = {0,0,0,0};
+
+    ASSERT_TRUE(ByteBuffer::interleave(v,pos,c[0],c[1]));
+    expectKey(buf,start,c,2);
+    EXPECT_EQ(buf[0],0xa5);
+    ASSERT_TRUE(ByteBuffer::deinterleave(v,pos,out[0],out[1]));
+    EXPECT_EQ(out[0],c[0]);
+    EXPECT_EQ(out[1],c[1]);
+
+    ASSERT_TRUE(ByteBuffer::interleave(v,pos,c[0],c[1],c[2]));
+    expectKey(buf,start,c,3);
+    ASSERT_TRUE(ByteBuffer::deinterleave(v,pos,out[0],out[1],out[2]));
+    EXPECT_EQ(out[2],c[2]);
+
+    ASSERT_TRUE(ByteBuffer::interleave(v,pos,c[0],c[1],c[2],c[3]));
+    expectKey(buf,start,c,4);
+    EXPECT_EQ(buf[18],0xa5);
+    ASSERT_TRUE(ByteBuffer::deinterleave(v,pos,out[0],out[1],out[2],out[3]));
+    EXPECT_EQ(out[3],c[3]);
+  }
+}
+
+/// @brief test if a key that does not fit is rejected
+TEST(Morton, InterleaveBeyondEnd_ShouldFail) {
+  std::vector<uint8_t> buf(12,0);
+  ByteBuffer::ByteBufferView v(buf.data(),buf.size());
+  EXPECT_TRUE(ByteBuffer::interleave(v,ByteBuffer::BitPosition(4,0),1u,2u));
+  EXPECT_FALSE(ByteBuffer::interleave(v,ByteBuffer::BitPosition(4,1),1u,2u));
+  EXPECT_FALSE(ByteBuffer::interleave(v,ByteBuffer::bitPositionZero,1u,2u,3u,4u));
+  EXPECT_EQ(buf,std::vector<uint8_t>({0,0,0,0,0x09,0,0,0,0,0,0,0}));
+}
+
+/***************************************************************************************************************
+ * Batches
+ ***************************************************************************************************************/
+
+/// @brief test if batch keys equal the single-point keys written back to back
+TEST(Morton, InterleaveBatch_ShouldMatchSinglePoints) {
+  uint32_t seed = 9;
+  const size_t n = 33;
+  std::vector<uint32_t> xs(n), ys(n), zs(n);
+  for (size_t i = 0; i < n; i++) {
+    xs[i] = TestUtil::nextRandom(seed);
+    ys[i] = TestUtil::nextRandom(seed);
+    zs[i] = TestUtil::nextRandom(seed);
+  }
+  std::vector<uint8_t> batch(n * 12 + 1,0);
+  std::vector<uint8_t> single(n * 12 + 1,0);
+  const uint32_t *in[3] = {xs.data(),ys.data(),zs.data()};
+  ASSERT_TRUE(ByteBuffer::interleaveBatch<3>(ByteBuffer::ByteBufferView(batch.data(),batch.size()),ByteBuffer::BitPosition(0,5),in,n));
+  for (size_t i = 0; i < n; i++) {
+    uint64_t bit = 5 + i * 96;
+    ByteBuffer::interleave(ByteBuffer::ByteBufferView(single.data(),single.size()),
+                           ByteBuffer::BitPosition(static_cast<uint32_t>(bit / 8),static_cast<uint8_t>(bit % 8)),xs[i],ys[i],zs[i]);
+  }
+  EXPECT_EQ(batch,single);
+  std::vector<uint32_t> ox(n), oy(n), oz(n);
+  uint32_t *out[3] = {ox.data(),oy.data(),oz.data()};
+  ASSERT_TRUE(ByteBuffer::deinterleaveBatch<3>(ByteBuffer::ConstByteBufferView(batch.data(),batch.size()),ByteBuffer::BitPosition(0,5),out,n));
+  EXPECT_EQ(ox,xs);
+  EXPECT_EQ(oy,ys);
+  EXPECT_EQ(oz,zs);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "PacketFilter.hpp"
+
+namespace {
+
+using Packet = ByteBuffer::ByteBuffer<64>;
+
+ByteBuffer::BitRange bits(uint32_t start, uint32_t count) {
+  return ByteBuffer::BitRange(ByteBuffer::BitPosition(start),ByteBuffer::BitPosition(start + count - 1));
+}
+
+/// @brief reference evaluation of the filter used in the batch tests via get
+bool reference(Packet &p) {
+  return p.get<uint32_t>(bits(0,4)) == 4 && p.get<uint32_t>(bits(70,12)) == 0xabc &&
+         p.get<uint32_t>(bits(200,16)) >= 1000 && p.get<uint32_t>(bits(200,16)) <= 2000;
+}
+
+}
+
+/***************************************************************************************************************
+ * Single buffer
+ ***************************************************************************************************************/
+
+/// @brief test if an empty filter matches every buffer
+TEST(PacketFilter, EmptyFilter_ShouldMatch) {
+  ByteBuffer::PacketFilter<64> f;
+  Packet p;
+  EXPECT_TRUE(f.matches(p));
+}
+
+/// @brief test if equality predicates compare the selected fields only
+/// Fields crossing a word boundary and the last byte are included
+TEST(PacketFilter, Equals_ShouldMatchFieldValues) {
+  ByteBuffer::PacketFilter<64> f;
+  f.equals(bits(0,4),4).equals(bits(60,8),0xa5).equals(bits(504,8),0x7f);
+  Packet p;
+  p.set(bits(0,4),4u);
+  p.set(bits(60,8),0xa5u);
+  p.set(bits(504,8),0x7fu);
+  p.set(bits(100,32),0xffffffffu);
+  EXPECT_TRUE(f.matches(p));
+  p.set(bits(62,1),0u);
+  EXPECT_FALSE(f.matches(p));
+}
+
+/// @brief test if contradicting equality predicates never match
+TEST(PacketFilter, ContradictingEquals_ShouldNeverMatch) {
+  ByteBuffer::PacketFilter<64> f;
+  f.equals(bits(8,8),0x12).equals(bits(12,4),0x2);
+  Packet p;
+  p.set(bits(8,8),0x12u);
+  EXPECT_FALSE(f.matches(p));
+}
+
+/// @brief test if an equality predicate with a value wider than its field never matches
+/// The value must not be truncated to the field width
+TEST(PacketFilter, EqualsValueWiderThanField_ShouldNeverMatch) {
+  ByteBuffer::PacketFilter<64> f;
+  f.equals(bits(8,4),0x13);
+  Packet p;
+  p.set(bits(8,4),0x3u);
+  EXPECT_FALSE(f.matches(p));
+  p.set(bits(8,8),0x13u);
+  EXPECT_FALSE(f.matches(p));
+}
+
+/// @brief test if range and set predicates check the field value
+TEST(PacketFilter, RangeAndSet_ShouldCheckFieldValue) {
+  ByteBuffer::PacketFilter<64> f;
+  f.inRange(bits(13,16),100,200).inSet(bits(40,8),{6,17,1});
+  Packet p;
+  p.set(bits(13,16),150u);
+  p.set(bits(40,8),17u);
+  EXPECT_TRUE(f.matches(p));
+  p.set(bits(40,8),18u);
+  EXPECT_FALSE(f.matches(p));
+  p.set(bits(40,8),6u);
+  p.set(bits(13,16),201u);
+  EXPECT_FALSE(f.matches(p));
+}
+
+/// @brief test if invalid fields are rejected
+TEST(PacketFilter, InvalidField_ShouldThrow) {
+  ByteBuffer::PacketFilter<8> f;
+  EXPECT_THROW(f.equals(bits(0,65),0),std::invalid_argument);
+  EXPECT_THROW(f.equals(bits(60,8),0),std::out_of_range);
+}
+
+/***************************************************************************************************************
+ * Batches
+ ***************************************************************************************************************/
+
+/// @brief test if a batch sets one bitmap bit per matching buffer
+/// The result is compared with an evaluation through get for buffers that match every second time
+TEST(PacketFilter, MatchBatch_ShouldEqualReference) {
+  ByteBuffer::PacketFilter<64> f;
+  f.equals(bits(0,4),4).equals(bits(70,12),0xabc).inRange(bits(200,16),1000,2000);
+  std::vector<Packet> packets(150);
+  std::vector<const Packet*> ptrs;
+  for (size_t i = 0; i < packets.size(); i++) {
+    packets[i].set(bits(0,4),static_cast<uint32_t>(i % 3 == 0 ? 4 : 5));
+    packets[i].set(bits(70,12),static_cast<uint32_t>(i % 5 == 0 ? 0xabd : 0xabc));
+    packets[i].set(bits(200,16),static_cast<uint32_t>(900 + i * 10));
+    ptrs.push_back(&packets[i]);
+  }
+  uint64_t bitmap[3];
+  uint64_t viaPtrs[3];
+  size_t hits = f.matchBatch(packets.data(),packets.size(),bitmap);
+  EXPECT_EQ(f.matchBatch(ptrs.data(),ptrs.size(),viaPtrs),hits);
+  size_t expected = 0;
+  for (size_t i = 0; i < packets.size(); i++) {
+    bool m = reference(packets[i]);
+    expected += m;
+    EXPECT_EQ((bitmap[i / 64] >> (i % 64)) & 1,static_cast<uint64_t>(m)) << i;
+    EXPECT_EQ((viaPtrs[i / 64] >> (i % 64)) & 1,static_cast<uint64_t>(m)) << i;
+  }
+  EXPECT_EQ(hits,expected);
+  EXPECT_NE(hits,0u);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ParallelOps.hpp"
+
+/***************************************************************************************************************
+ * Thread pool
+ ***************************************************************************************************************/
+
+/// @brief test if every task index is executed exactly once
+/// parallelFor runs each index once across all threads
+TEST(ParallelOps, ParallelForOverManyTasks_ShouldRunEveryIndexOnce) {
+  ByteBuffer::ThreadPool pool(4);
+  std::vector<int> hits(1000,0);
+
+  for (int round = 0; round < 3; round++) {
+    pool.parallelFor(hits.size(),[&](size_t i) { hits[i]++; });
+  }
+
+  for (int h : hits) {
+    EXPECT_EQ(h,3);
+  }
+}
+
+/***************************************************************************************************************
+ * Bulk operations
+ ***************************************************************************************************************/
+
+/// @brief test if parallel fill writes every byte
+/// Filling a large unaligned view with a pattern changes exactly the viewed bytes
+TEST(ParallelOps, ParallelFillOfUnalignedView_ShouldFillExactlyTheView) {
+  ByteBuffer::ThreadPool pool(4);
+  std::vector<uint8_t> mem(100003,0);
+  ByteBuffer::ByteBufferView v(mem.data() + 3,mem.size() - 4);
+
+  ByteBuffer::parallelFill(pool,v,0xa5,0);
+
+  EXPECT_EQ(mem[2],0);
+  EXPECT_EQ(mem[3],0xa5);
+  EXPECT_EQ(mem[mem.size() - 2],0xa5);
+  EXPECT_EQ(mem[mem.size() - 1],0);
+}
+
+/// @brief test if parallel popcount matches the serial result
+/// Counting bits in parallel returns the same value as the serial count
+TEST(ParallelOps, ParallelPopcount_ShouldMatchSerialPopcount) {
+  ByteBuffer::ThreadPool pool(4);
+  std::vector<uint8_t> mem(65537);
+  for (size_t i = 0; i < mem.size(); i++) {
+    mem[i] = static_cast<uint8_t>(i * 37);
+  }
+  ByteBuffer::ConstByteBufferView v(mem.data() + 1,mem.size() - 1);
+
+  EXPECT_EQ(ByteBuffer::parallelPopcount(pool,v,0),ByteBuffer::popcount(v));
+}
+
+/// @brief test if popcount of a ByteBuffer is working
+/// A ByteBuffer converts to a view and counts its set bits
+TEST(ParallelOps, PopcountOfByteBuffer_ShouldReturnNumberOfSetBits) {
+  ByteBuffer::ByteBuffer<12> b;
+  b.set(ByteBuffer::BitPosition(9,3),static_cast<uint8_t>(0b1011),4);
+
+  EXPECT_EQ(ByteBuffer::popcount(b),3u);
+}
+
+/// @brief test if parallel combine applies the operation to every byte
+/// Combining two views with xor in parallel yields the xor of both views
+TEST(ParallelOps, ParallelCombineWithXor_ShouldXorEveryByte) {
+  ByteBuffer::ThreadPool pool(4);
+  std::vector<uint8_t> a(50000,0x0f);
+  std::vector<uint8_t> b(50000,0xff);
+
+  ByteBuffer::parallelCombine(pool,ByteBuffer::ByteBufferView(a.data(),a.size()),ByteBuffer::ConstByteBufferView(b.data(),b.size()),ByteBuffer::BitwiseOp::Xor,0);
+
+  for (uint8_t x : a) {
+    ASSERT_EQ(x,0xf0);
+  }
+}
+
+/// @brief test if parallel search returns the first set bit
+/// The earliest of several set bits is found across chunk boundaries
+TEST(ParallelOps, ParallelFindFirstSet_ShouldReturnEarliestSetBit) {
+  ByteBuffer::ThreadPool pool(4);
+  std::vector<uint8_t> mem(200000,0);
+  mem[150000] = 0x01;
+  mem[70001] = 0x20;
+  ByteBuffer::ConstByteBufferView v(mem.data(),mem.size());
+
+  EXPECT_EQ(ByteBuffer::parallelFindFirstSet(pool,v,0),ByteBuffer::BitPosition(70001,5));
+  EXPECT_EQ(ByteBuffer::parallelFindByte(pool,v,0x01,0),ByteBuffer::BitPosition(150000,0));
+}
+
+/// @brief test if parallel search reports missing bits
+/// Searching an empty view returns bitPositionMax
+TEST(ParallelOps, ParallelFindFirstSetInEmptyBuffer_ShouldReturnBitPositionMax) {
+  ByteBuffer::ThreadPool pool(4);
+  std::vector<uint8_t> mem(100000,0);
+
+  EXPECT_EQ(ByteBuffer::parallelFindFirstSet(pool,ByteBuffer::ConstByteBufferView(mem.data(),mem.size()),0),ByteBuffer::bitPositionMax);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "PatternSearch.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+constexpr uint64_t syncWord = 0x1acffc1d;
+
+/// @brief naive reference: slide a position and compare get<uint64_t> at every offset
+template <size_t Bytes>
+ByteBuffer::BitPosition naiveFind(ByteBuffer::ByteBuffer<Bytes> &b, uint64_t pattern, uint8_t nbits, ByteBuffer::BitPosition start) {
+  for (ByteBuffer::BitPosition pos = start; pos + nbits <= ByteBuffer::BitPosition(Bytes,0); pos++) {
+    if (b.template get<uint64_t>(pos,nbits) == pattern) {
+      return pos;
+    }
+  }
+  return ByteBuffer::bitPositionMax;
+}
+
+}
+
+/***************************************************************************************************************
+ * Exact pattern search
+ ***************************************************************************************************************/
+
+/// @brief test if a sync word is found at every bit offset
+/// A 32 bit pattern written at any bit position is found at exactly that position
+TEST(PatternSearch, FindPatternAtEveryBitOffset_ShouldReturnInsertPosition) {
+  for (uint32_t bit = 0; bit < 40 * 8 - 32; bit++) {
+    ByteBuffer::ByteBuffer<40> b;
+    b.set(ByteBuffer::BitPosition(bit),static_cast<uint32_t>(syncWord),32);
+
+    EXPECT_EQ(ByteBuffer::findPattern(b,syncWord,32),ByteBuffer::BitPosition(bit));
+  }
+}
+
+/// @brief test if the search starts at the given position
+/// A match before the start position is skipped
+TEST(PatternSearch, FindPatternFromStartPosition_ShouldSkipEarlierMatches) {
+  ByteBuffer::ByteBuffer<64> b;
+  b.set(ByteBuffer::BitPosition(3,3),static_cast<uint16_t>(0xbeef),16);
+  b.set(ByteBuffer::BitPosition(40,6),static_cast<uint16_t>(0xbeef),16);
+
+  EXPECT_EQ(ByteBuffer::findPattern(b,0xbeef,16,ByteBuffer::BitPosition(3,4)),ByteBuffer::BitPosition(40,6));
+  EXPECT_EQ(ByteBuffer::findPattern(b,0xbeef,16,ByteBuffer::BitPosition(40,7)),ByteBuffer::bitPositionMax);
+}
+
+/// @brief test if the search agrees with a naive scan on pseudo random data
+/// Short patterns found in noise start at the same position as found by sliding get calls
+TEST(PatternSearch, FindPatternInNoise_ShouldMatchNaiveScan) {
+  ByteBuffer::ByteBuffer<200> b;
+  TestUtil::fillRandom(b.data(),b.size(),12345);
+
+  for (uint8_t nbits = 9; nbits <= 17; nbits += 4) {
+    uint64_t pattern = b.get<uint64_t>(ByteBuffer::BitPosition(150,5),nbits);
+    ByteBuffer::BitPosition start(10,1);
+    EXPECT_EQ(ByteBuffer::findPattern(b,pattern,nbits,start),naiveFind(b,pattern,nbits,start));
+  }
+}
+
+/// @brief test if a 64 bit pattern at the very end of the buffer is found
+/// The last possible start position is included in the search
+TEST(PatternSearch, Find64BitPatternAtBufferEnd_ShouldReturnLastPosition) {
+  ByteBuffer::ByteBuffer<12> b;
+  b.set(ByteBuffer::BitPosition(4,0),static_cast<uint64_t>(0x0123456789abcdefu),64);
+
+  EXPECT_EQ(ByteBuffer::findPattern(b,0x0123456789abcdefu,64),ByteBuffer::BitPosition(4,0));
+}
+
+/***************************************************************************************************************
+ * Tolerant pattern search
+ ***************************************************************************************************************/
+
+/// @brief test if a corrupted sync word is found with enough tolerance
+/// A pattern with two flipped bits is found with tolerance 2 but not with tolerance 1
+TEST(PatternSearch, FindCorruptedPatternTolerant_ShouldRespectMismatchLimit) {
+  ByteBuffer::ByteBuffer<32> b;
+  b.set(ByteBuffer::BitPosition(9,5),static_cast<uint32_t>(syncWord ^ 0x00100200),32);
+
+  EXPECT_EQ(ByteBuffer::findPattern(b,syncWord,32),ByteBuffer::bitPositionMax);
+  EXPECT_EQ(ByteBuffer::findPatternTolerant(b,syncWord,32,1),ByteBuffer::bitPositionMax);
+  EXPECT_EQ(ByteBuffer::findPatternTolerant(b,syncWord,32,2),ByteBuffer::BitPosition(9,5));
+}
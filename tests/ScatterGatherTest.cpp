@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "DynamicByteBuffer.hpp"
+#include "ScatterGather.hpp"
+
+namespace {
+
+/// @brief pipe or socketpair closed on destruction; `fd[0]` reads, `fd[1]` writes
+struct Channel {
+  explicit Channel(bool socket) {
+    int rc = socket ? ::socketpair(AF_UNIX,SOCK_STREAM,0,fd) : ::pipe(fd);
+    EXPECT_EQ(rc,0);
+  }
+  ~Channel() {
+    closeEnd(0);
+    closeEnd(1);
+  }
+  void closeEnd(int i) {
+    if (fd[i] >= 0) {
+      ::close(fd[i]);
+      fd[i] = -1;
+    }
+  }
+  int fd[2] = {-1,-1};
+};
+
+}
+
+/***************************************************************************************************************
+ * Gather writes
+ ***************************************************************************************************************/
+
+/// @brief test if header, options and payload leave a pipe as one contiguous message
+TEST(ScatterGather, WriteVectored_ShouldConcatenateParts) {
+  Channel pipe(false);
+  ByteBuffer::ByteBuffer<4> header;
+  header.set(ByteBuffer::BitPosition(0,0),0xcafe0102u,32);
+  ByteBuffer::DynamicByteBuffer options;
+  options.append(0xabu,8);
+  options.append(0xcdu,8);
+  std::vector<uint8_t> payload = {1,2,3,4,5};
+  ssize_t n = ByteBuffer::writeVectored(pipe.fd[1],{header,options,
+                                                     ByteBuffer::ConstByteBufferView(nullptr,0),
+                                                     ByteBuffer::ConstByteBufferView(payload.data(),payload.size())});
+  ASSERT_EQ(n,11);
+
+  ByteBuffer::ByteBuffer<11> in;
+  ASSERT_EQ(ByteBuffer::readInto(pipe.fd[0],in),11);
+  EXPECT_EQ(in.get<uint32_t>(ByteBuffer::BitPosition(0,0),32),0xcafe0102u);
+  EXPECT_EQ(in.getData()[4],0xab);
+  EXPECT_EQ(in.getData()[5],0xcd);
+  EXPECT_EQ(in.getData()[10],5);
+}
+
+/// @brief test if a message with more parts than one call takes and more bytes than the pipe holds arrives intact
+TEST(ScatterGather, LargeWrite_ShouldResumeAfterShortWrites) {
+  Channel pipe(false);
+  const size_t parts = 150;
+  const size_t partSize = 1500;
+  std::vector<uint8_t> data(parts * partSize);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i * 7 + i / 251);
+  }
+  std::vector<ByteBuffer::ConstByteBufferView> views;
+  for (size_t p = 0; p < parts; p++) {
+    views.emplace_back(data.data() + p * partSize,partSize);
+  }
+  std::vector<uint8_t> received(data.size());
+  ssize_t got = 0;
+  std::thread reader([&]() {
+    got = ByteBuffer::readInto(pipe.fd[0],ByteBuffer::ByteBufferView(received.data(),received.size()));
+  });
+  ssize_t sent = ByteBuffer::writeVectored(pipe.fd[1],views.data(),views.size());
+  reader.join();
+  EXPECT_EQ(sent,static_cast<ssize_t>(data.size()));
+  EXPECT_EQ(got,static_cast<ssize_t>(data.size()));
+  EXPECT_EQ(received,data);
+}
+
+/***************************************************************************************************************
+ * Sockets and scatter reads
+ ***************************************************************************************************************/
+
+/// @brief test if a message sent on a socketpair is scattered back into separate buffers
+TEST(ScatterGather, SendVectoredThenReadVectored_ShouldSplitMessage) {
+  Channel sockets(true);
+  ByteBuffer::ByteBuffer<3> a;
+  ByteBuffer::ByteBuffer<5> b;
+  a.fill(0x11);
+  b.fill(0x22);
+  ASSERT_EQ(ByteBuffer::sendVectored(sockets.fd[1],{a,b},MSG_NOSIGNAL),8);
+
+  ByteBuffer::ByteBuffer<2> x;
+  ByteBuffer::ByteBuffer<6> y;
+  ASSERT_EQ(ByteBuffer::readVectored(sockets.fd[0],{x,y}),8);
+  EXPECT_EQ(x.getData()[1],0x11);
+  EXPECT_EQ(y.getData()[0],0x11);
+  EXPECT_EQ(y.getData()[1],0x22);
+  EXPECT_EQ(y.getData()[5],0x22);
+}
+
+/// @brief test if end of file gives a short count and a closed peer or descriptor gives an error
+TEST(ScatterGather, EndOfFileAndErrors_ShouldBeReported) {
+  Channel sockets(true);
+  ByteBuffer::ByteBuffer<4> out;
+  ASSERT_EQ(ByteBuffer::sendVectored(sockets.fd[1],{out},MSG_NOSIGNAL),4);
+  sockets.closeEnd(1);
+  ByteBuffer::ByteBuffer<16> in;
+  EXPECT_EQ(ByteBuffer::readInto(sockets.fd[0],in),4);
+  EXPECT_EQ(ByteBuffer::readInto(sockets.fd[0],in),0);
+
+  errno = 0;
+  EXPECT_EQ(ByteBuffer::sendVectored(sockets.fd[0],{out},MSG_NOSIGNAL),-1);
+  EXPECT_EQ(errno,EPIPE);
+  EXPECT_EQ(ByteBuffer::writeVectored(-1,{out}),-1);
+  EXPECT_EQ(errno,EBADF);
+}
+
+/// @brief test if a peer closing mid-transfer gives the bytes sent so far instead of -1
+/// The count lets the caller resume or resynchronise; errno tells why the transfer stopped
+TEST(ScatterGather, PeerClosesMidTransfer_ShouldReturnBytesSent) {
+  Channel sockets(true);
+  std::vector<uint8_t> data(1 << 22,0x5a);
+  std::vector<ByteBuffer::ConstByteBufferView> views;
+  for (size_t p = 0; p < 4; p++) {
+    views.emplace_back(data.data() + p * (data.size() / 4),data.size() / 4);
+  }
+  std::thread reader([&]() {
+    ByteBuffer::ByteBuffer<4096> in;
+    ByteBuffer::readInto(sockets.fd[0],in);
+    sockets.closeEnd(0);
+  });
+  errno = 0;
+  ssize_t sent = ByteBuffer::sendVectored(sockets.fd[1],views.data(),views.size(),MSG_NOSIGNAL);
+  int err = errno;
+  reader.join();
+  EXPECT_GT(sent,0);
+  EXPECT_LT(sent,static_cast<ssize_t>(data.size()));
+  EXPECT_TRUE(err == EPIPE || err == ECONNRESET) << err;
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "SeqLockedByteBuffer.hpp"
+
+/***************************************************************************************************************
+ * Single thread
+ ***************************************************************************************************************/
+
+/// @brief test if published fields read back through fields, proxies and snapshots
+TEST(SeqLockedByteBuffer, SetThenGet_ShouldReturnPublishedValues) {
+  ByteBuffer::SeqLockedByteBuffer<13> b;
+  ByteBuffer::BitRange status(ByteBuffer::BitPosition(7,5),static_cast<uint16_t>(12));
+  EXPECT_EQ(b.sequence(),0u);
+  b.set(status,0xabcu);
+  b.set(ByteBuffer::BitPosition(12,7),1u,1);
+  EXPECT_EQ(b.sequence(),4u);
+  EXPECT_EQ(b.get<uint32_t>(status),0xabcu);
+  EXPECT_TRUE(b.hasValue(status,0xabc));
+  EXPECT_TRUE(b.isSet(ByteBuffer::BitPosition(12,7)));
+  EXPECT_FALSE(b.isSet(ByteBuffer::BitPosition(12,6)));
+  EXPECT_EQ(b.get<uint16_t>(ByteBuffer::BitPosition(12,6),8),2u);
+
+  ByteBuffer::ByteBuffer<13> s = b.snapshot();
+  EXPECT_EQ(s.get<uint32_t>(status),0xabcu);
+  EXPECT_EQ(s.getData()[12],0x80);
+}
+
+/// @brief test if all writes of one update are published together as one sequence step
+TEST(SeqLockedByteBuffer, Update_ShouldPublishBatchedWrites) {
+  ByteBuffer::ByteBuffer<16> initial;
+  initial.fill(0x11);
+  ByteBuffer::SeqLockedByteBuffer<16> b(initial);
+  EXPECT_EQ(b.get<uint64_t>(ByteBuffer::BitRange(ByteBuffer::BitPosition(4,0),static_cast<uint16_t>(64))),0x1111111111111111u);
+  b.update([](ByteBuffer::ByteBuffer<16> &w) {
+    w.set(ByteBuffer::BitPosition(0,0),0xffu,8);
+    w.set(ByteBuffer::BitPosition(15,0),0x22u,8);
+  });
+  EXPECT_EQ(b.sequence(),2u);
+  ByteBuffer::ByteBuffer<16> s = b.snapshot();
+  EXPECT_EQ(s.getData()[0],0xff);
+  EXPECT_EQ(s.getData()[1],0x11);
+  EXPECT_EQ(s.getData()[15],0x22);
+  EXPECT_EQ(b.writerView().getData()[15],0x22);
+}
+
+/// @brief test if ranges outside the buffer or wider than 64 bits are rejected
+TEST(SeqLockedByteBuffer, InvalidRange_ShouldThrow) {
+  ByteBuffer::SeqLockedByteBuffer<8> b;
+  EXPECT_THROW(b.get<uint32_t>(ByteBuffer::BitRange(ByteBuffer::BitPosition(7,4),static_cast<uint16_t>(8))),std::out_of_range);
+  ByteBuffer::SeqLockedByteBuffer<16> w;
+  EXPECT_THROW(w.get<uint64_t>(ByteBuffer::BitRange(ByteBuffer::BitPosition(0,0),static_cast<uint16_t>(65))),std::invalid_argument);
+}
+
+/***************************************************************************************************************
+ * Concurrent readers
+ ***************************************************************************************************************/
+
+/// @brief test if readers never observe a half-published update
+/// Every update writes the same counter into each 32-bit slot, so any mix of two updates is detected
+TEST(SeqLockedByteBuffer, ConcurrentReaders_ShouldSeeConsistentValues) {
+  ByteBuffer::SeqLockedByteBuffer<24> b;
+  std::atomic<bool> done{false};
+  std::atomic<size_t> torn{0};
+  auto reader = [&]() {
+    while (!done.load()) {
+      ByteBuffer::ByteBuffer<24> s = b.snapshot();
+      uint32_t first = s.get<uint32_t>(ByteBuffer::BitPosition(0,0),32);
+      for (uint32_t i = 1; i < 6; i++) {
+        if (s.get<uint32_t>(ByteBuffer::BitPosition(i * 4,0),32) != first) {
+          torn++;
+        }
+      }
+      // a field straddling two words
+      uint64_t mid = b.get<uint64_t>(ByteBuffer::BitRange(ByteBuffer::BitPosition(4,0),static_cast<uint16_t>(64)));
+      if (static_cast<uint32_t>(mid) != static_cast<uint32_t>(mid >> 32)) {
+        torn++;
+      }
+      std::this_thread::yield();
+    }
+  };
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 2; i++) {
+    readers.emplace_back(reader);
+  }
+  for (uint32_t n = 1; n <= 20000; n++) {
+    b.update([n](ByteBuffer::ByteBuffer<24> &w) {
+      for (uint32_t i = 0; i < 6; i++) {
+        w.set(ByteBuffer::BitPosition(i * 4,0),n,32);
+      }
+    });
+  }
+  done = true;
+  for (std::thread &t : readers) {
+    t.join();
+  }
+  EXPECT_EQ(torn.load(),0u);
+  EXPECT_EQ(b.get<uint32_t>(ByteBuffer::BitPosition(20,0),32),20000u);
+}
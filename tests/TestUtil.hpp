@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/// @brief deterministic pseudo-random data shared by the tests; the sequences only depend on the seed
+namespace TestUtil {
+
+/// @brief advance the 32-bit LCG state and return it
+inline uint32_t nextLcg(uint32_t &seed) {
+  seed = seed * 1664525u + 1013904223u;
+  return seed;
+}
+
+/// @brief advance the 32-bit LCG and return the state with its low bits mixed with the high ones
+inline uint32_t nextRandom(uint32_t &seed) {
+  nextLcg(seed);
+  return seed ^ (seed >> 13);
+}
+
+/// @brief 64-bit variant of `nextRandom` for tests that need more than 32 bits per step
+inline uint64_t nextRandom(uint64_t &seed) {
+  seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+  return seed ^ (seed >> 29);
+}
+
+/// @brief fill `n` bytes at `p` with the top byte of successive LCG states
+inline void fillRandom(uint8_t *p, size_t n, uint32_t seed) {
+  for (size_t i = 0; i < n; i++) {
+    p[i] = static_cast<uint8_t>(nextLcg(seed) >> 24);
+  }
+}
+
+/// @brief return `n` bytes filled like `fillRandom`
+inline std::vector<uint8_t> pseudoRandom(size_t n, uint32_t seed) {
+  std::vector<uint8_t> out(n);
+  fillRandom(out.data(),n,seed);
+  return out;
+}
+
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "XorDelta.hpp"
+#include "TestUtil.hpp"
+
+namespace {
+
+std::vector<uint8_t> randomFrame(size_t size, uint32_t seed) {
+  std::vector<uint8_t> f(size);
+  for (uint8_t &b : f) {
+    b = static_cast<uint8_t>(TestUtil::nextRandom(seed));
+  }
+  return f;
+}
+
+ByteBuffer::ConstByteBufferView view(const std::vector<uint8_t> &v) {
+  return ByteBuffer::ConstByteBufferView(v.data(),v.size());
+}
+
+}
+
+/***************************************************************************************************************
+ * Encoding
+ ***************************************************************************************************************/
+
+/// @brief test if a few flipped bits of a 4 KB frame give a small delta that restores the frame
+/// Each changed word costs its 8 literal bytes plus its counts; skips above 127 words take two bytes
+TEST(XorDelta, FewChangedBits_ShouldGiveSmallDelta) {
+  std::vector<uint8_t> prev = randomFrame(4096,1);
+  std::vector<uint8_t> next = prev;
+  next[3] ^= 0x10;
+  next[1000] ^= 0x01;
+  next[2047] ^= 0x80;
+  next[4095] ^= 0x04;
+  ByteBuffer::DynamicByteBuffer delta;
+  ASSERT_TRUE(ByteBuffer::encodeXorDelta(view(prev),view(next),delta));
+  EXPECT_EQ(delta.size(),2u + 4 * 10 + 2);
+  std::vector<uint8_t> frame = prev;
+  ASSERT_TRUE(ByteBuffer::applyXorDelta(ByteBuffer::ByteBufferView(frame.data(),frame.size()),delta));
+  EXPECT_EQ(frame,next);
+}
+
+/// @brief test if frames of odd sizes with changed runs, gaps and a partial last word round-trip
+TEST(XorDelta, RandomChanges_ShouldRoundTrip) {
+  uint32_t seed = 7;
+  for (size_t size : {1u,7u,8u,33u,100u,517u}) {
+    std::vector<uint8_t> prev = randomFrame(size,static_cast<uint32_t>(size));
+    std::vector<uint8_t> next = prev;
+    for (size_t k = 0; k < size / 5 + 1; k++) {
+      next[TestUtil::nextRandom(seed) % size] ^= static_cast<uint8_t>(1u << (TestUtil::nextRandom(seed) % 8));
+    }
+    ByteBuffer::DynamicByteBuffer delta;
+    ASSERT_TRUE(ByteBuffer::encodeXorDelta(view(prev),view(next),delta));
+    std::vector<uint8_t> frame = prev;
+    ASSERT_TRUE(ByteBuffer::applyXorDelta(ByteBuffer::ByteBufferView(frame.data(),frame.size()),delta));
+    EXPECT_EQ(frame,next) << size;
+  }
+}
+
+/// @brief test if identical frames give a delta holding only the size
+TEST(XorDelta, IdenticalFrames_ShouldGiveSizeOnly) {
+  ByteBuffer::ByteBuffer<64> a;
+  a.fill(0x5a);
+  ByteBuffer::ByteBuffer<64> b = a;
+  ByteBuffer::DynamicByteBuffer delta;
+  ASSERT_TRUE(ByteBuffer::encodeXorDelta(a,b,delta));
+  ASSERT_EQ(delta.size(),1u);
+  EXPECT_EQ(delta.getData()[0],64);
+  EXPECT_TRUE(ByteBuffer::applyXorDelta(a,delta));
+  EXPECT_EQ(a.getData()[63],0x5a);
+}
+
+/***************************************************************************************************************
+ * Errors
+ ***************************************************************************************************************/
+
+/// @brief test if mismatching sizes and damaged deltas are rejected without touching the frame
+TEST(XorDelta, InvalidDelta_ShouldFail) {
+  std::vector<uint8_t> prev = randomFrame(100,3);
+  std::vector<uint8_t> next = prev;
+  next[10] ^= 1;
+  next[90] ^= 1;
+  ByteBuffer::DynamicByteBuffer delta;
+  EXPECT_FALSE(ByteBuffer::encodeXorDelta(view(prev),ByteBuffer::ConstByteBufferView(next.data(),99),delta));
+  ASSERT_TRUE(ByteBuffer::encodeXorDelta(view(prev),view(next),delta));
+
+  std::vector<uint8_t> frame = prev;
+  EXPECT_FALSE(ByteBuffer::applyXorDelta(ByteBuffer::ByteBufferView(frame.data(),99),delta));
+  EXPECT_FALSE(ByteBuffer::applyXorDelta(ByteBuffer::ByteBufferView(frame.data(),frame.size()),
+                                         ByteBuffer::ConstByteBufferView(delta.getData(),delta.size() - 1)));
+  EXPECT_EQ(frame,prev);
+}